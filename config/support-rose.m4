@@ -2209,6 +2209,7 @@ tests/CompileTests/mixLanguage_tests/Makefile
 tests/CompileTests/Matlab_tests/Makefile
 tests/CompileTests/STL_tests/Makefile
 tests/CompilerOptionsTests/collectAllCommentsAndDirectives_tests/Makefile
+tests/CompilerOptionsTests/cacheCommentsAndDirectives_tests/Makefile
 tests/CompilerOptionsTests/preinclude_tests/Makefile
 tests/CompilerOptionsTests/tokenStream_tests/Makefile
 tests/roseTests/Makefile
@@ -30,6 +30,7 @@
 #include "PropertyValueTable.h"
 #include "CTIOLabeler.h"
 #include "VariableValueMonitor.h"
+#include "WorkListStealing.h"
 
 // we use INT_MIN, INT_MAX
 #include "limits.h"
@@ -111,6 +112,17 @@ namespace CodeThorn {
     const EState* topWorkList();
     const EState* popWorkList();
     void swapWorkLists();
+    // per-thread work lists with work stealing, used by solver 5 if enabled
+    void setWorkStealing(bool workStealing) { _workStealing=workStealing; }
+    bool getWorkStealing() { return _workStealing; }
+    // true if the solver actually used per-thread work lists (false if it fell back to the shared work list)
+    bool getWorkStealingUsed() { return _workStealingUsed; }
+    bool startWorkStealing(int numThreads);
+    void stopWorkStealing();
+    WorkListStealing<const EState*>::Statistics getWorkListStealingStatistics() { return _estateWorkListStealing.statistics(); }
+    // stores the bindings of new pstates in memory-mapped files in directory
+    void setStateSpillDirectory(string directory);
+    StateSpillArea* getStateSpillArea() { return _stateSpillArea; }
     
     void recordTransition(const EState* sourceEState, Edge e, const EState* targetEState);
     void printStatusMessage(bool);
@@ -445,6 +457,11 @@ namespace CodeThorn {
     int _curr_iteration_cnt;
     int _next_iteration_cnt;
     bool _externalFunctionSemantics;
+    WorkListStealing<const EState*> _estateWorkListStealing;
+    bool _workStealing;
+    bool _workStealingActive;
+    bool _workStealingUsed;
+    StateSpillArea* _stateSpillArea;
     string _externalErrorFunctionName; // the call of this function causes termination of analysis
     string _externalNonDetIntFunctionName;
     string _externalNonDetLongFunctionName;
@@ -11,7 +11,7 @@
 #include "HSet.h"
 using namespace br_stl;
 #else
-#include <boost/unordered_set.hpp>
+#include "ShardedHSet.h"
 #endif
 
 //#include "/usr/include/valgrind/memcheck.h"
@@ -20,13 +20,18 @@ using namespace br_stl;
 /*! 
   * \author Markus Schordan
   * \date 2012.
+  *
+  * Unless USE_CUSTOM_HSET is defined, the elements are kept in a
+  * ShardedHSet. The determine and process functions lock only the shard
+  * that the element hashes to, so that threads exploring different states
+  * rarely wait for each other.
  */
 template<typename KeyType,typename HashFun, typename EqualToPred>
 class HSetMaintainer 
 #ifdef USE_CUSTOM_HSET
   : public HSet<KeyType*,HashFun,EqualToPred>
 #else
-  : public boost::unordered_set<KeyType*,HashFun,EqualToPred>
+  : public ShardedHSet<KeyType*,HashFun,EqualToPred>
 #endif
   {
 public:
@@ -39,7 +44,7 @@ public:
 #ifdef USE_CUSTOM_HSET
     typename HSet<KeyType*,HashFun,EqualToPred>::const_iterator i;
 #else
-    typename boost::unordered_set<KeyType*,HashFun,EqualToPred>::const_iterator i;
+    typename ShardedHSet<KeyType*,HashFun,EqualToPred>::const_iterator i;
 #endif
     i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(s);
     if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
@@ -48,7 +53,7 @@ public:
 #ifdef USE_CUSTOM_HSET
       typename HSet<KeyType*,HashFun,EqualToPred>::const_iterator b;
 #else
-      typename boost::unordered_set<KeyType*,HashFun,EqualToPred>::const_iterator b;
+      typename ShardedHSet<KeyType*,HashFun,EqualToPred>::const_iterator b;
 #endif
       b=HSetMaintainer<KeyType,HashFun,EqualToPred>::begin();
       while(b!=i) {
@@ -65,66 +70,64 @@ public:
 
   KeyType* determine(KeyType& s) { 
     KeyType* ret=0;
+#ifdef USE_CUSTOM_HSET
     typename HSetMaintainer<KeyType,HashFun,EqualToPred>::iterator i;
 #pragma omp critical(HASHSET)
     {
-#ifdef USE_CUSTOM_HSET
       i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(s);
       if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
         ret=const_cast<KeyType*>(&(*i));
       } else {
         ret=0;
       }
+    }
 #else
-      i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(&s);
-      if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
-        ret=const_cast<KeyType*>(*i);
-      } else {
-        ret=0;
-      }
+    ret=this->lookup(&s);
 #endif
-    }
     return ret;
   }
 
   const KeyType* determine(const KeyType& s) { 
     const KeyType* ret=0;
+#ifdef USE_CUSTOM_HSET
     typename HSetMaintainer<KeyType,HashFun,EqualToPred>::iterator i;
 #pragma omp critical(HASHSET)
     {
-#ifdef USE_CUSTOM_HSET
       i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(s);
       if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
         ret=&(*i);
       } else {
         ret=0;
       }
+    }
 #else
-      i=HSetMaintainer<KeyType,HashFun,EqualToPred>::find(const_cast<KeyType*>(&s));
-      if(i!=HSetMaintainer<KeyType,HashFun,EqualToPred>::end()) {
-        ret=const_cast<KeyType*>(*i);
-      } else {
-        ret=0;
-      }
+    ret=this->lookup(const_cast<KeyType*>(&s));
 #endif
-    }
     return ret;
   }
 
   ProcessingResult process(const KeyType* key) {
     ProcessingResult res2;
+    // the caller hands over a heap allocated element, which is stored
+    // (and passed to 'stored') as is if no equal element exists yet
+    KeyType* newKey=const_cast<KeyType*>(key);
+#ifdef USE_CUSTOM_HSET
 #pragma omp critical(HASHSET)
     {
       std::pair<typename HSetMaintainer::iterator, bool> res;
-      typename HSetMaintainer::iterator iter=this->find(const_cast<KeyType*>(key)); // TODO: eliminate const_cast
+      typename HSetMaintainer::iterator iter=this->find(newKey);
       if(iter!=this->end()) {
         // found it!
         res=make_pair(iter,false);
       } else {
-        res=this->insert(const_cast<KeyType*>(key)); // TODO: eliminate const_cast
+        stored(newKey);
+        res=this->insert(newKey);
       }
       res2=make_pair(res.second,*res.first);
     }
+#else
+    res2=this->lookupOrInsert(newKey,StoreKey(this));
+#endif
     return res2;
   }
   const KeyType* processNewOrExisting(const KeyType* s) {
@@ -136,6 +139,10 @@ public:
   //! <false,const KeyType> if element already existed
   ProcessingResult process(KeyType key) {
     ProcessingResult res2;
+#ifndef USE_CUSTOM_HSET
+    // the copy is made with only the element's shard locked
+    res2=this->lookupOrInsert(&key,StoreCopy(this));
+#else
 #pragma omp critical(HASHSET)
     {
     std::pair<typename HSetMaintainer::iterator, bool> res;
@@ -150,6 +157,7 @@ public:
       //       this requires a more detailed result: pointer exists, alternate pointer with equal object exists, does not exist
       KeyType* keyPtr=new KeyType();
       *keyPtr=key;
+      stored(keyPtr);
       res=this->insert(keyPtr);
     }
 #ifdef HSET_MAINTAINER_DEBUG_MODE
@@ -167,6 +175,7 @@ public:
 #endif
     res2=make_pair(res.second,*res.first);
     }
+#endif
     return res2;
   }
   const KeyType* processNew(KeyType& s) {
@@ -191,14 +200,7 @@ public:
 #ifdef USE_CUSTOM_HSET
     return HSetMaintainer<KeyType,HashFun,EqualToPred>::max_collisions();
 #else
-    //MS:2012
-    size_t max=0;
-    for(size_t i=0; i<HSetMaintainer<KeyType,HashFun,EqualToPred>::bucket_count();++i) {
-      if(HSetMaintainer<KeyType,HashFun,EqualToPred>::bucket_size(i)>max) {
-        max=HSetMaintainer<KeyType,HashFun,EqualToPred>::bucket_size(i);
-      }
-    }
-    return max;
+    return HSetMaintainer<KeyType,HashFun,EqualToPred>::max_bucket_size();
 #endif
   }
 
@@ -217,8 +219,35 @@ public:
     return mem+sizeof(*this);
   }
 
+ protected:
+  //! called for each new element before it is inserted (and becomes visible
+  //! to other threads); the element may still be modified if its hash value
+  //! and equality are preserved
+  virtual void stored(KeyType* key) {}
+
  private:
   //const KeyType* ptr(KeyType& s) {}
+
+  // element constructors for ShardedHSet::lookupOrInsert
+  struct StoreKey {
+    StoreKey(HSetMaintainer* maintainer):maintainer(maintainer) {}
+    KeyType* operator()(KeyType* key) const {
+      maintainer->stored(key);
+      return key;
+    }
+    HSetMaintainer* maintainer;
+  };
+  struct StoreCopy {
+    StoreCopy(HSetMaintainer* maintainer):maintainer(maintainer) {}
+    // converting the stack allocated object to heap allocated
+    // this copies the entire object
+    KeyType* operator()(KeyType* key) const {
+      KeyType* copy=new KeyType(*key);
+      maintainer->stored(copy);
+      return copy;
+    }
+    HSetMaintainer* maintainer;
+  };
 };
 
 #endif
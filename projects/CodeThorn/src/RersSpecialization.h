@@ -6,13 +6,13 @@
 
 // integer variables
 #define INIT_GLOBALVAR(VARNAME) VARNAME = new int[numberOfThreads];
-#define COPY_PSTATEVAR_TO_GLOBALVAR(VARNAME) VARNAME[thread_id] = pstate[analyzer->globalVarIdByName(STR_VALUE(VARNAME))].getIntValue();
+#define COPY_PSTATEVAR_TO_GLOBALVAR(VARNAME) VARNAME[thread_id] = pstate.varValue(analyzer->globalVarIdByName(STR_VALUE(VARNAME))).getIntValue();
 //cout<<"PSTATEVAR:"<<pstate[analyzer->globalVarIdByName(STR_VALUE(VARNAME))].toString()<<"="<<pstate[analyzer->globalVarIdByName(STR_VALUE(VARNAME))].toString()<<endl;
-#define COPY_GLOBALVAR_TO_PSTATEVAR(VARNAME) pstate[analyzer->globalVarIdByName(STR_VALUE(VARNAME))]=CodeThorn::AType::ConstIntLattice(VARNAME[thread_id]);
+#define COPY_GLOBALVAR_TO_PSTATEVAR(VARNAME) pstate.setVariableToValue(analyzer->globalVarIdByName(STR_VALUE(VARNAME)),CodeThorn::AType::ConstIntLattice(VARNAME[thread_id]));
 
 // pointers to integer variables
 #define INIT_GLOBALPTR(VARNAME) VARNAME = new int*[numberOfThreads]; 
-#define COPY_PSTATEPTR_TO_GLOBALPTR(VARNAME) VARNAME[thread_id] = analyzer->mapGlobalVarAddress[analyzer->getVarNameByIdCode(pstate[analyzer->globalVarIdByName(STR_VALUE(VARNAME))].getIntValue())]
+#define COPY_PSTATEPTR_TO_GLOBALPTR(VARNAME) VARNAME[thread_id] = analyzer->mapGlobalVarAddress[analyzer->getVarNameByIdCode(pstate.varValue(analyzer->globalVarIdByName(STR_VALUE(VARNAME))).getIntValue())]
 #define COPY_GLOBALPTR_TO_PSTATEPTR(VARNAME) pstate[analyzer->globalVarIdByName(STR_VALUE(VARNAME))]=CodeThorn::AType::ConstIntLattice(analyzer->globalVarIdByName(analyzer->mapAddressGlobalVar[VARNAME[thread_id]]).getIdCode());
 
 // create an entry in the mapping    <var_address>  <-->  <var_name>
@@ -0,0 +1,261 @@
+#ifndef SHARDED_HSET_H
+#define SHARDED_HSET_H
+
+/*************************************************************
+ * License  : see file LICENSE in the CodeThorn distribution *
+ *************************************************************/
+
+#include <boost/cstdint.hpp>
+#include <boost/unordered_set.hpp>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+  * \brief Hash set of pointers that is split into independently locked shards.
+  *
+  * Each element is stored in one of NumShards boost::unordered_sets, selected
+  * by its hash value, and each shard has its own lock. Threads that look up or
+  * insert elements that fall into different shards do not wait for each other.
+  * The hash value of an element is computed once and stored next to the
+  * pointer, where it is reused for selecting the shard, for rehashing when a
+  * shard grows, and as a cheap inequality test before the equality predicate
+  * is invoked.
+  *
+  * The container functions (find, insert, erase, iteration) are not
+  * synchronized, as in boost::unordered_set. Concurrent access must use
+  * lookup() and lookupOrInsert(), which lock only the affected shard. The
+  * number of elements is updated atomically and can be read at any time.
+  * Element pointers are never moved or copied by the container.
+ */
+template<typename KeyPtr, typename HashFun, typename EqualToPred, size_t NumShards=64>
+class ShardedHSet {
+ public:
+  //! element pointer together with its cached hash value
+  struct Entry {
+    Entry(KeyPtr ptr, size_t hash):ptr(ptr),hash(hash) {}
+    KeyPtr ptr;
+    size_t hash;
+  };
+
+ private:
+  struct EntryHashFun {
+    size_t operator()(const Entry& e) const { return e.hash; }
+  };
+  struct EntryEqualToPred {
+    bool operator()(const Entry& e1, const Entry& e2) const {
+      return e1.hash==e2.hash && (e1.ptr==e2.ptr || EqualToPred()(e1.ptr,e2.ptr));
+    }
+  };
+  typedef boost::unordered_set<Entry,EntryHashFun,EntryEqualToPred> Shard;
+
+ public:
+  /*!
+   * \brief Forward iterator over all elements of all shards.
+   * Dereferencing yields the stored element pointer.
+   */
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef KeyPtr value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const KeyPtr* pointer;
+    typedef const KeyPtr& reference;
+
+    const_iterator():_set(0),_shard(NumShards) {}
+    const KeyPtr& operator*() const { return _iter->ptr; }
+    const KeyPtr* operator->() const { return &_iter->ptr; }
+    const_iterator& operator++() {
+      ++_iter;
+      skipEmptyShards();
+      return *this;
+    }
+    const_iterator operator++(int) {
+      const_iterator old=*this;
+      ++*this;
+      return old;
+    }
+    bool operator==(const const_iterator& other) const {
+      return _shard==other._shard && (_shard==NumShards || _iter==other._iter);
+    }
+    bool operator!=(const const_iterator& other) const { return !(*this==other); }
+  private:
+    friend class ShardedHSet;
+    const_iterator(const ShardedHSet* set, size_t shard, typename Shard::const_iterator iter)
+      :_set(set),_shard(shard),_iter(iter) {
+      skipEmptyShards();
+    }
+    void skipEmptyShards() {
+      while(_shard<NumShards && _iter==_set->_shards[_shard].end()) {
+        if(++_shard<NumShards)
+          _iter=_set->_shards[_shard].begin();
+      }
+    }
+    const ShardedHSet* _set;
+    size_t _shard;
+    typename Shard::const_iterator _iter;
+  };
+  //! elements are immutable, therefore iterator and const_iterator are the same
+  typedef const_iterator iterator;
+
+  ShardedHSet():_size(0) { initLocks(); }
+  ShardedHSet(const ShardedHSet& other):_size(other._size) {
+    for(size_t i=0;i<NumShards;++i)
+      _shards[i]=other._shards[i];
+    initLocks();
+  }
+  ShardedHSet& operator=(const ShardedHSet& other) {
+    for(size_t i=0;i<NumShards;++i)
+      _shards[i]=other._shards[i];
+    _size=other._size;
+    return *this;
+  }
+  ~ShardedHSet() {
+#ifdef _OPENMP
+    for(size_t i=0;i<NumShards;++i)
+      omp_destroy_lock(&_locks[i]);
+#endif
+  }
+
+  const_iterator begin() const { return const_iterator(this,0,_shards[0].begin()); }
+  const_iterator end() const { return const_iterator(); }
+  size_t size() const {
+    long n;
+#pragma omp atomic read
+    n=_size;
+    return (size_t)n;
+  }
+  bool empty() const { return size()==0; }
+
+  const_iterator find(KeyPtr key) const {
+    Entry e=entry(key);
+    size_t s=shardIndex(e.hash);
+    typename Shard::const_iterator i=_shards[s].find(e);
+    return i==_shards[s].end() ? end() : const_iterator(this,s,i);
+  }
+  std::pair<const_iterator,bool> insert(KeyPtr key) {
+    Entry e=entry(key);
+    size_t s=shardIndex(e.hash);
+    std::pair<typename Shard::const_iterator,bool> res=_shards[s].insert(e);
+    if(res.second)
+      incrementSize(1);
+    return std::make_pair(const_iterator(this,s,res.first),res.second);
+  }
+  void erase(const_iterator pos) {
+    _shards[pos._shard].erase(pos._iter);
+    incrementSize(-1);
+  }
+  size_t erase(KeyPtr key) {
+    Entry e=entry(key);
+    size_t n=_shards[shardIndex(e.hash)].erase(e);
+    incrementSize(-(long)n);
+    return n;
+  }
+  void clear() {
+    for(size_t i=0;i<NumShards;++i)
+      _shards[i].clear();
+    _size=0;
+  }
+
+  //! thread-safe lookup; returns the stored pointer equal to key, or 0
+  KeyPtr lookup(KeyPtr key) {
+    Entry e=entry(key);
+    size_t s=shardIndex(e.hash);
+    KeyPtr ret=0;
+    lockShard(s);
+    typename Shard::const_iterator i=_shards[s].find(e);
+    if(i!=_shards[s].end())
+      ret=i->ptr;
+    unlockShard(s);
+    return ret;
+  }
+
+  /*!
+   * \brief Thread-safe lookup with insertion.
+   * If an element equal to key exists, returns <false,existing pointer>.
+   * Otherwise inserts makeStored(key) and returns <true,inserted pointer>.
+   * makeStored is called with the shard lock held and must return a pointer
+   * equal to key (e.g. key itself, or a heap-allocated copy).
+   */
+  template<typename MakeStored>
+  std::pair<bool,KeyPtr> lookupOrInsert(KeyPtr key, MakeStored makeStored) {
+    Entry e=entry(key);
+    size_t s=shardIndex(e.hash);
+    std::pair<bool,KeyPtr> ret;
+    lockShard(s);
+    typename Shard::const_iterator i=_shards[s].find(e);
+    if(i!=_shards[s].end()) {
+      ret=std::make_pair(false,i->ptr);
+    } else {
+      e.ptr=makeStored(key);
+      _shards[s].insert(e);
+      incrementSize(1);
+      ret=std::make_pair(true,e.ptr);
+    }
+    unlockShard(s);
+    return ret;
+  }
+
+  void max_load_factor(float f) {
+    for(size_t i=0;i<NumShards;++i)
+      _shards[i].max_load_factor(f);
+  }
+  float load_factor() const {
+    size_t buckets=0;
+    for(size_t i=0;i<NumShards;++i)
+      buckets+=_shards[i].bucket_count();
+    return buckets==0 ? 0.0f : (float)size()/buckets;
+  }
+  //! size of the largest bucket over all shards
+  size_t max_bucket_size() const {
+    size_t max=0;
+    for(size_t i=0;i<NumShards;++i) {
+      for(size_t b=0;b<_shards[i].bucket_count();++b) {
+        if(_shards[i].bucket_size(b)>max)
+          max=_shards[i].bucket_size(b);
+      }
+    }
+    return max;
+  }
+
+ private:
+  static Entry entry(KeyPtr key) {
+    return Entry(key,(size_t)HashFun()(key));
+  }
+  // most hash functions in CodeThorn produce at most 32 significant bits,
+  // which are mixed so that the shard is independent of the bucket index
+  static size_t shardIndex(size_t hash) {
+    return (size_t)((((boost::uint64_t)hash*0x9e3779b97f4a7c15ULL)>>32)%NumShards);
+  }
+  void incrementSize(long n) {
+#pragma omp atomic
+    _size+=n;
+  }
+  void initLocks() {
+#ifdef _OPENMP
+    for(size_t i=0;i<NumShards;++i)
+      omp_init_lock(&_locks[i]);
+#endif
+  }
+  void lockShard(size_t s) {
+#ifdef _OPENMP
+    omp_set_lock(&_locks[s]);
+#endif
+  }
+  void unlockShard(size_t s) {
+#ifdef _OPENMP
+    omp_unset_lock(&_locks[s]);
+#endif
+  }
+
+  Shard _shards[NumShards];
+#ifdef _OPENMP
+  omp_lock_t _locks[NumShards];
+#endif
+  long _size;
+};
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef SHARED_FLAT_MAP_H
+#define SHARED_FLAT_MAP_H
+
+/*************************************************************
+ * License  : see file LICENSE in the CodeThorn distribution *
+ *************************************************************/
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*!
+  * \brief Sorted associative array with shared storage and a cached hash value.
+  *
+  * The elements are kept in one contiguous array sorted by key, which costs
+  * one allocation per map instead of one per element and makes lookups a
+  * binary search. Copies of a map share the array (copying is O(1)); the
+  * array is copied on the first modification of a map whose array is
+  * shared, so a sequence of modifications of a copy copies the elements
+  * only once.
+  *
+  * The hash value of a map is the sum of EntryHashFun()(key,value) over all
+  * elements. It is updated in O(1) by assign(), insert() and erase(key).
+  * Functions that hand out a mutable reference or iterator (non-const
+  * begin(), end(), find(), and operator[]) cannot track what is written
+  * through it; they mark the hash value as stale and the next call of
+  * hash() recomputes it. Code that only reads a non-const map should use
+  * cbegin(), cend() and cfind(), which neither copy a shared array nor mark
+  * the hash value as stale.
+  *
+  * The interface is a subset of std::map's. Iterators are plain pointers
+  * into the array and are invalidated by any modification of the map.
+  *
+  * moveStorageTo() moves the array into memory provided by an allocator
+  * that outlives the map (e.g. a memory-mapped file). The map then refers
+  * to that memory until it is modified, which copies the elements back to
+  * the heap.
+ */
+template<typename Key, typename Value, typename EntryHashFun>
+class SharedFlatMap {
+ public:
+  typedef Key key_type;
+  typedef Value mapped_type;
+  typedef std::pair<Key,Value> value_type;
+  typedef value_type* iterator;
+  typedef const value_type* const_iterator;
+  typedef size_t size_type;
+
+ private:
+  typedef std::vector<value_type> Entries;
+  struct KeyLess {
+    bool operator()(const value_type& e, const Key& k) const { return e.first<k; }
+  };
+
+ public:
+  SharedFlatMap():_external(0),_hash(0),_hashValid(true) {}
+
+  const_iterator begin() const {
+    if(_entries)
+      return _entries->empty() ? 0 : &_entries->front();
+    return _external ? reinterpret_cast<const value_type*>(_external+1) : 0;
+  }
+  const_iterator end() const { return begin()+size(); }
+  iterator begin() { return mutableEntries(); }
+  iterator end() { return mutableEntries()+size(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  size_type size() const { return _entries ? _entries->size() : (_external ? *_external : 0); }
+  bool empty() const { return size()==0; }
+
+  const_iterator find(const Key& key) const {
+    const_iterator i=lowerBound(key);
+    return (i!=end() && !(key<i->first)) ? i : end();
+  }
+  iterator find(const Key& key) {
+    size_t pos=cfind(key)-cbegin();
+    return begin()+pos;
+  }
+  const_iterator cfind(const Key& key) const { return find(key); }
+  size_type count(const Key& key) const { return find(key)==end() ? 0 : 1; }
+
+  //! inserts a default-constructed value if key does not exist (as std::map)
+  Value& operator[](const Key& key) {
+    iterator i=insert(value_type(key,Value())).first;
+    _hashValid=false;
+    return i->second;
+  }
+
+  //! sets the value of key, inserting key if it does not exist
+  void assign(const Key& key, const Value& value) {
+    size_t pos=lowerBound(key)-cbegin();
+    Entries& entries=unshare();
+    if(pos<entries.size() && !(key<entries[pos].first)) {
+      if(_hashValid)
+        _hash-=EntryHashFun()(entries[pos].first,entries[pos].second);
+      entries[pos].second=value;
+    } else {
+      entries.insert(entries.begin()+pos,value_type(key,value));
+    }
+    if(_hashValid)
+      _hash+=EntryHashFun()(key,value);
+  }
+
+  std::pair<iterator,bool> insert(const value_type& entry) {
+    size_t pos=lowerBound(entry.first)-cbegin();
+    bool inserted=(pos==size() || entry.first<(cbegin()+pos)->first);
+    Entries& entries=unshare();
+    if(inserted) {
+      entries.insert(entries.begin()+pos,entry);
+      if(_hashValid)
+        _hash+=EntryHashFun()(entry.first,entry.second);
+    }
+    return std::make_pair(&entries[pos],inserted);
+  }
+
+  size_type erase(const Key& key) {
+    const_iterator i=cfind(key);
+    if(i==cend())
+      return 0;
+    size_t pos=i-cbegin();
+    if(_hashValid)
+      _hash-=EntryHashFun()(i->first,i->second);
+    Entries& entries=unshare();
+    entries.erase(entries.begin()+pos);
+    return 1;
+  }
+  void erase(iterator pos) {
+    // pos was obtained from a non-const member function, therefore the
+    // array is not shared and not external
+    if(_hashValid)
+      _hash-=EntryHashFun()(pos->first,pos->second);
+    _entries->erase(_entries->begin()+(pos-&_entries->front()));
+  }
+  void clear() {
+    _entries.reset();
+    _external=0;
+    _hash=0;
+    _hashValid=true;
+  }
+
+  //! sum of the hash values of all elements
+  size_t hash() const {
+    if(!_hashValid) {
+      size_t hash=0;
+      for(const_iterator i=begin();i!=end();++i)
+        hash+=EntryHashFun()(i->first,i->second);
+      _hash=hash;
+      _hashValid=true;
+    }
+    return _hash;
+  }
+
+  //! true if both maps use the same array (and are therefore equal)
+  bool sharesStorageWith(const SharedFlatMap& other) const {
+    return (_entries && _entries==other._entries) || (_external && _external==other._external);
+  }
+
+  /*!
+   * \brief Moves the elements into memory obtained from area.allocate(bytes).
+   * The memory must be aligned for size_t and value_type and must remain
+   * valid as long as the map (or a copy of it) refers to it. The elements
+   * are never destroyed there, therefore value_type must not need a
+   * destructor. Does nothing for empty maps and maps already moved.
+   */
+  template<typename Area>
+  void moveStorageTo(Area& area) {
+    if(!_entries || _entries->empty())
+      return;
+    size_t n=_entries->size();
+    size_t* mem=static_cast<size_t*>(area.allocate(sizeof(size_t)+n*sizeof(value_type)));
+    *mem=n;
+    std::uninitialized_copy(_entries->begin(),_entries->end(),reinterpret_cast<value_type*>(mem+1));
+    _external=mem;
+    _entries.reset();
+  }
+  //! true if the elements are stored in memory provided to moveStorageTo
+  bool usesExternalStorage() const { return _external!=0; }
+
+  bool operator==(const SharedFlatMap& other) const {
+    if(size()!=other.size())
+      return false;
+    if(sharesStorageWith(other))
+      return true;
+    if(_hashValid && other._hashValid && _hash!=other._hash)
+      return false;
+    return std::equal(begin(),end(),other.begin());
+  }
+  bool operator!=(const SharedFlatMap& other) const { return !(*this==other); }
+
+ private:
+  const_iterator lowerBound(const Key& key) const {
+    return std::lower_bound(begin(),end(),key,KeyLess());
+  }
+  // makes the array exclusively owned by this map
+  Entries& unshare() {
+    if(!_entries) {
+      boost::shared_ptr<Entries> entries=boost::make_shared<Entries>();
+      if(_external) {
+        entries->reserve(*_external+1);
+        entries->assign(cbegin(),cend());
+        _external=0;
+      }
+      _entries=entries;
+    } else if(!_entries.unique()) {
+      boost::shared_ptr<Entries> copy=boost::make_shared<Entries>();
+      copy->reserve(_entries->size()+1);
+      copy->assign(_entries->begin(),_entries->end());
+      _entries=copy;
+    }
+    return *_entries;
+  }
+  iterator mutableEntries() {
+    if(empty())
+      return 0;
+    _hashValid=false;
+    return &unshare().front();
+  }
+
+  boost::shared_ptr<Entries> _entries;
+  // element count followed by the elements, if moved by moveStorageTo
+  const size_t* _external;
+  mutable size_t _hash;
+  mutable bool _hashValid;
+};
+
+#endif
@@ -26,6 +26,8 @@ typedef int EStateId;
 
 #include "HashFun.h"
 #include "HSetMaintainer.h"
+#include "SharedFlatMap.h"
+#include "StateSpillArea.h"
 
 using CodeThorn::AValue;
 using CodeThorn::ConstraintSet;
@@ -38,11 +40,35 @@ namespace CodeThorn {
 
   class VariableValueMonitor;
   class Analyzer;
+
+/*!
+  * \brief Hash value of one variable binding of a PState.
+  * The bits of the variable id and the value are mixed, such that the sum
+  * over all bindings (the PState hash) distinguishes states which differ
+  * only in the assignment of values to variables.
+ */
+class PStateEntryHashFun {
+ public:
+  size_t operator()(const VariableId& varId, const CodeThorn::AValue& val) const {
+    unsigned long long h=((unsigned long long)(unsigned int)varId.getIdCode()<<32)^(unsigned long long)val.hash();
+    h^=h>>33;
+    h*=0xff51afd7ed558ccdULL;
+    h^=h>>33;
+    h*=0xc4ceb9fe1a85ec53ULL;
+    h^=h>>33;
+    return (size_t)h;
+  }
+};
+
 /*! 
   * \author Markus Schordan
   * \date 2012.
+  * \details The bindings are stored in a SharedFlatMap: copying a PState
+  * is O(1), the bindings are copied once when a copy is first modified, and
+  * the hash value is maintained by setVariableToValue and deleteVar.
+  * Stored states can move their bindings to a StateSpillArea (see spill).
  */
-class PState : public map<VariableId,CodeThorn::AValue> {
+class PState : public SharedFlatMap<VariableId,CodeThorn::AValue,PStateEntryHashFun> {
  public:
     PState() {
     }
@@ -54,6 +80,10 @@ class PState : public map<VariableId,CodeThorn::AValue> {
   AValue varValue(VariableId varId) const;
   string varValueToString(VariableId varId) const;
   void deleteVar(VariableId varname);
+  //! moves the bindings into area; the state remains valid (and can be modified)
+  void spill(StateSpillArea& area);
+  bool isSpilled() const;
+  //! size in main memory (excluding spilled bindings)
   long memorySize() const;
   void fromStream(istream& is);
   void toStream(ostream& os) const;
@@ -83,11 +113,7 @@ class PStateHashFun {
    public:
     PStateHashFun(long prime=9999991) : tabSize(prime) {}
     long operator()(PState s) const {
-      unsigned int hash=1;
-      for(PState::iterator i=s.begin();i!=s.end();++i) {
-        hash=((hash<<8)+((long)(*i).second.hash()))^hash;
-      }
-      return long(hash) % tabSize;
+      return long(s.hash() % tabSize);
     }
       long tableSize() const { return tabSize;}
    private:
@@ -98,11 +124,7 @@ class PStateHashFun {
    public:
     PStateHashFun() {}
     long operator()(PState* s) const {
-      unsigned int hash=1;
-      for(PState::iterator i=s->begin();i!=s->end();++i) {
-        hash=((hash<<8)+((long)(*i).second.hash()))^hash;
-      }
-      return long(hash);
+      return long(s->hash());
     }
    private:
 };
@@ -111,15 +133,7 @@ class PStateEqualToPred {
    public:
     PStateEqualToPred() {}
     bool operator()(PState* s1, PState* s2) const {
-      if(s1->size()!=s2->size()) {
-        return false;
-      } else {
-        for(PState::iterator i1=s1->begin(), i2=s2->begin();i1!=s1->end();(++i1,++i2)) {
-          if(*i1!=*i2)
-            return false;
-        }
-      }
-      return true;
+      return *s1==*s2;
     }
    private:
 };
@@ -130,12 +144,23 @@ class PStateEqualToPred {
  */
  class PStateSet : public HSetMaintainer<PState,PStateHashFun,PStateEqualToPred> {
  public:
+  PStateSet():_spillArea(0) {}
   typedef HSetMaintainer<PState,PStateHashFun,PStateEqualToPred>::ProcessingResult ProcessingResult;
   string toString();
   PStateId pstateId(const PState* pstate);
   PStateId pstateId(const PState pstate);
   string pstateIdString(const PState* pstate);
+  /*!
+   * \brief Spills the bindings of all states stored from now on to area (0 disables spilling).
+   * Lookups compare the in-memory hash values first, therefore spilled
+   * bindings are only read when a state with the same hash is processed.
+   */
+  void setSpillArea(StateSpillArea* area) { _spillArea=area; }
+  StateSpillArea* getSpillArea() const { return _spillArea; }
+ protected:
+  void stored(PState* pstate);
  private:
+  StateSpillArea* _spillArea;
 };
 
 /*! 
@@ -0,0 +1,62 @@
+#ifndef STATE_SPILL_AREA_H
+#define STATE_SPILL_AREA_H
+
+/*************************************************************
+ * License  : see file LICENSE in the CodeThorn distribution *
+ *************************************************************/
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace CodeThorn {
+
+/*!
+  * \brief Append-only memory area backed by memory-mapped files.
+  *
+  * Memory is allocated from chunks that are mapped from files created in a
+  * directory (preferably on a local disk). The files are unlinked as soon
+  * as they are mapped and therefore disappear when the area is destroyed or
+  * the process ends. Since the pages are backed by files, the operating
+  * system writes pages that have not been used recently to disk and
+  * discards them when memory is needed, without using swap space.
+  *
+  * Allocated memory is never freed individually; it remains valid until
+  * the area is destroyed. allocate() is thread-safe.
+ */
+class StateSpillArea {
+ public:
+  //! chunkSize is the size of each mapped file (larger allocations get a file of their own)
+  StateSpillArea(std::string directory, size_t chunkSize=256*1024*1024);
+  ~StateSpillArea();
+  //! returns memory aligned to 8 bytes; throws a string on failure
+  void* allocate(size_t bytes);
+  std::string directory() const { return _directory; }
+  //! number of bytes handed out by allocate
+  size_t bytesAllocated() const { return _bytesAllocated; }
+  //! total size of all mapped files
+  size_t bytesMapped() const { return _bytesMapped; }
+  size_t numberOfFiles() const { return _chunks.size(); }
+  std::string toString() const;
+ private:
+  char* mapChunk(size_t size);
+  std::string _directory;
+  size_t _chunkSize;
+  std::vector<std::pair<char*,size_t> > _chunks;
+  char* _current;
+  size_t _available;
+  size_t _bytesAllocated;
+  size_t _bytesMapped;
+#ifdef _OPENMP
+  omp_lock_t _lock;
+#endif
+  StateSpillArea(const StateSpillArea&);
+  StateSpillArea& operator=(const StateSpillArea&);
+};
+
+} // end of namespace CodeThorn
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef WORKLISTSTEALING_H
+#define WORKLISTSTEALING_H
+
+/*************************************************************
+ * License  : see file LICENSE in the CodeThorn distribution *
+ *************************************************************/
+
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <sstream>
+#include <string>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace CodeThorn {
+
+/*!
+  * \brief Work list for parallel solvers with one queue per thread and work stealing.
+  *
+  * Each thread adds elements to its own queue and takes elements from its
+  * own queue. Only a thread whose queue is empty accesses the queues of
+  * other threads: it steals the oldest element of the first non-empty queue
+  * it finds. The queues are protected by one lock each, which is therefore
+  * almost never contended.
+  *
+  * In DEPTH_FIRST mode a thread takes its most recently added element and
+  * thieves steal from the other end (the oldest elements, which are close
+  * to the root of the explored state space and tend to lead to large
+  * amounts of work). In BREADTH_FIRST mode threads take their oldest
+  * element, which explores the states of each queue in order of their
+  * depth.
+  *
+  * The number of elements is maintained atomically, so isEmpty() and size()
+  * can be called at any time. The order in which elements are taken is not
+  * deterministic if more than one thread is used; WorkListSeq provides a
+  * deterministic order.
+ */
+template <typename Element>
+class WorkListStealing {
+ public:
+  enum Mode { DEPTH_FIRST, BREADTH_FIRST };
+
+  //! counters summed over all queues
+  struct Statistics {
+    Statistics():numAdded(0),numTaken(0),numStolen(0),numFailedSteals(0),idleTime(0.0),maxQueueDepth(0),avgQueueDepth(0.0) {}
+    long numAdded;
+    long numTaken;
+    //! elements taken from the queue of another thread
+    long numStolen;
+    //! attempts to take an element when all queues were empty
+    long numFailedSteals;
+    //! time in seconds threads spent between failing and succeeding to take an element
+    double idleTime;
+    //! maximum and average queue size after adding an element
+    size_t maxQueueDepth;
+    double avgQueueDepth;
+    std::string toString() const {
+      std::stringstream ss;
+      ss<<"added:"<<numAdded<<", taken:"<<numTaken<<", stolen:"<<numStolen
+        <<", failed-steals:"<<numFailedSteals<<", idle:"<<idleTime<<"s"
+        <<", queue-depth(max/avg):"<<maxQueueDepth<<"/"<<avgQueueDepth;
+      return ss.str();
+    }
+  };
+
+  WorkListStealing():_queues(0),_numQueues(0),_mode(DEPTH_FIRST),_size(0) { reset(1,DEPTH_FIRST); }
+  ~WorkListStealing() { delete[] _queues; }
+
+  //! removes all elements and statistics; must not be called while other threads use the work list
+  void reset(size_t numThreads, Mode mode) {
+    delete[] _queues;
+    _numQueues=numThreads>0?numThreads:1;
+    _queues=new Queue[_numQueues];
+    _mode=mode;
+    _size=0;
+  }
+  size_t numberOfQueues() const { return _numQueues; }
+  Mode mode() const { return _mode; }
+
+  bool isEmpty() const { return size()==0; }
+  size_t size() const {
+    long n;
+#pragma omp atomic read
+    n=_size;
+    return (size_t)n;
+  }
+
+  //! adds elem to the queue of the calling thread
+  void add(Element elem) { add(elem,threadQueue()); }
+  //! adds elem to the queue with the specified index (e.g. to distribute initial work)
+  void add(Element elem, size_t queue) {
+    Queue& q=_queues[queue%_numQueues];
+    q.lock();
+    q.elements.push_back(elem);
+    size_t depth=q.elements.size();
+    q.count=depth;
+    q.numAdded++;
+    q.sumQueueDepth+=depth;
+    if(depth>q.maxQueueDepth)
+      q.maxQueueDepth=depth;
+    q.unlock();
+    incrementSize(1);
+  }
+
+  /*!
+   * \brief Takes an element from the calling thread's queue, or steals one.
+   * Returns false if all queues were found empty. Another thread may add
+   * elements later, therefore callers must use their own termination
+   * detection.
+   */
+  bool take(Element& elem) {
+    size_t self=threadQueue();
+    Queue& q=_queues[self];
+    bool found=false;
+    q.lock();
+    if(!q.elements.empty()) {
+      if(_mode==DEPTH_FIRST) {
+        elem=q.elements.back();
+        q.elements.pop_back();
+      } else {
+        elem=q.elements.front();
+        q.elements.pop_front();
+      }
+      q.count=q.elements.size();
+      found=true;
+    }
+    q.unlock();
+    if(!found) {
+      for(size_t i=1;i<_numQueues && !found;++i) {
+        Queue& victim=_queues[(self+i)%_numQueues];
+        // unsynchronized test to avoid locking empty queues; rechecked below
+        if(victim.count==0)
+          continue;
+        victim.lock();
+        if(!victim.elements.empty()) {
+          elem=victim.elements.front();
+          victim.elements.pop_front();
+          victim.count=victim.elements.size();
+          found=true;
+        }
+        victim.unlock();
+      }
+      if(found)
+        q.numStolen++;
+    }
+    if(found) {
+      incrementSize(-1);
+      q.numTaken++;
+      if(q.idleSince>=0.0) {
+        q.idleTime+=wtime()-q.idleSince;
+        q.idleSince=-1.0;
+      }
+    } else {
+      q.numFailedSteals++;
+      idle();
+    }
+    return found;
+  }
+
+  /*!
+   * \brief Records that the calling thread has no work.
+   * The time until the thread takes its next element is counted as idle
+   * time. take() calls this when it finds no element; solvers that test
+   * isEmpty() instead of calling take() should call it as well.
+   */
+  void idle() {
+    Queue& q=_queues[threadQueue()];
+    if(q.idleSince<0.0)
+      q.idleSince=wtime();
+  }
+
+  bool exists(Element elem) {
+    bool found=false;
+    for(size_t i=0;i<_numQueues && !found;++i) {
+      Queue& q=_queues[i];
+      q.lock();
+      for(typename std::deque<Element>::iterator j=q.elements.begin();j!=q.elements.end();++j) {
+        if(*j==elem) {
+          found=true;
+          break;
+        }
+      }
+      q.unlock();
+    }
+    return found;
+  }
+
+  //! appends all remaining elements to list (oldest first) and empties the work list
+  void moveTo(std::list<Element>& list) {
+    for(size_t i=0;i<_numQueues;++i) {
+      Queue& q=_queues[i];
+      q.lock();
+      list.insert(list.end(),q.elements.begin(),q.elements.end());
+      incrementSize(-(long)q.elements.size());
+      q.elements.clear();
+      q.count=0;
+      q.unlock();
+    }
+  }
+
+  //! must not be called while other threads use the work list
+  Statistics statistics() const {
+    Statistics stats;
+    long sumQueueDepth=0;
+    double now=wtime();
+    for(size_t i=0;i<_numQueues;++i) {
+      const Queue& q=_queues[i];
+      stats.numAdded+=q.numAdded;
+      stats.numTaken+=q.numTaken;
+      stats.numStolen+=q.numStolen;
+      stats.numFailedSteals+=q.numFailedSteals;
+      stats.idleTime+=q.idleTime;
+      if(q.idleSince>=0.0)
+        stats.idleTime+=now-q.idleSince;
+      if(q.maxQueueDepth>stats.maxQueueDepth)
+        stats.maxQueueDepth=q.maxQueueDepth;
+      sumQueueDepth+=q.sumQueueDepth;
+    }
+    if(stats.numAdded>0)
+      stats.avgQueueDepth=(double)sumQueueDepth/stats.numAdded;
+    return stats;
+  }
+
+ private:
+  // queue of one thread with its lock and counters. The counters are only
+  // updated by the owning thread (or under the lock in add).
+  struct Queue {
+    Queue():count(0),numAdded(0),numTaken(0),numStolen(0),numFailedSteals(0),sumQueueDepth(0),maxQueueDepth(0),idleTime(0.0),idleSince(-1.0) {
+#ifdef _OPENMP
+      omp_init_lock(&_lock);
+#endif
+    }
+    ~Queue() {
+#ifdef _OPENMP
+      omp_destroy_lock(&_lock);
+#endif
+    }
+    void lock() {
+#ifdef _OPENMP
+      omp_set_lock(&_lock);
+#endif
+    }
+    void unlock() {
+#ifdef _OPENMP
+      omp_unset_lock(&_lock);
+#endif
+    }
+    std::deque<Element> elements;
+    // size of elements, which other threads read without the lock
+    volatile size_t count;
+    long numAdded;
+    long numTaken;
+    long numStolen;
+    long numFailedSteals;
+    long sumQueueDepth;
+    size_t maxQueueDepth;
+    double idleTime;
+    double idleSince;
+#ifdef _OPENMP
+    omp_lock_t _lock;
+#endif
+    // keeps the queues of different threads in different cache lines
+    char _padding[64];
+  private:
+    Queue(const Queue&);
+    Queue& operator=(const Queue&);
+  };
+
+  size_t threadQueue() const {
+#ifdef _OPENMP
+    return (size_t)omp_get_thread_num()%_numQueues;
+#else
+    return 0;
+#endif
+  }
+  static double wtime() {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return 0.0;
+#endif
+  }
+  void incrementSize(long n) {
+#pragma omp atomic
+    _size+=n;
+  }
+
+  Queue* _queues;
+  size_t _numQueues;
+  Mode _mode;
+  long _size;
+ private:
+  WorkListStealing(const WorkListStealing&);
+  WorkListStealing& operator=(const WorkListStealing&);
+};
+
+} // end of namespace CodeThorn
+
+#endif
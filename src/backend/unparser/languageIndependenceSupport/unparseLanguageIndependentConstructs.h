@@ -134,6 +134,12 @@ class UnparseLanguageIndependentConstructs
              }
 #endif
           void curprint (const std::string & str) const;
+
+       // Output the lexemes of tokenVector[start..end] (inclusive) as a single write to the output stream.
+       // Unmodified statements are unparsed from the token stream token by token; coalescing the range
+       // avoids one formatted stream insertion per token.
+          void unparseTokenRange (const SgTokenPtrList & tokenVector, int start, int end) const;
+
           void printOutComments ( SgLocatedNode* locatedNode ) const;
 
       //! Unparser support for compiler-generated statments
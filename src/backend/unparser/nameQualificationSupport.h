@@ -21,9 +21,48 @@
 //    7) What about base class qualification? I might have forgotten this one! No this is handled using standard rules (above).
 
 
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
+
 // API function for new hidden list support.
 void generateNameQualificationSupport( SgNode* node, std::set<SgNode*> & referencedNameSet );
 
+// Cache of qualifier strings computed by NameQualificationTraversal::setNameQualificationSupport().
+// The qualifier generated for a reference depends only on the scope where the named construct is declared and on
+// the amount of qualification required, so the same string (e.g. "std::" or "boost::detail::") is otherwise
+// rebuilt for every reference by walking the scopes and constructing their names.  Entries are keyed by the
+// (scope, qualification length) pair and hashed on the pointer value.  A single cache is shared by the top-level
+// traversal of a file and all of its nested traversals, so each distinct qualifier string is built (and stored) once.
+// Qualifiers passing through template class scopes are not cached since their names are generated by unparsing
+// the template arguments, which depends on name qualification that may not have been computed yet.
+class NameQualificationQualifierCache
+   {
+     public:
+          struct Entry
+             {
+               std::string qualifier;
+               int amountOfNameQualificationRequired;
+               bool globalQualification;
+             };
+
+          typedef std::pair<SgScopeStatement*,int> Key;
+
+          NameQualificationQualifierCache();
+
+       // Returns the cached entry or NULL if there is none.
+          const Entry* find(SgScopeStatement* scope, int inputNameQualificationLength);
+          void insert(SgScopeStatement* scope, int inputNameQualificationLength, const Entry & entry);
+
+          size_t get_hits() const;
+          size_t get_misses() const;
+          size_t size() const;
+
+     private:
+          boost::unordered_map<Key,Entry,boost::hash<Key> > entries;
+          size_t hits;
+          size_t misses;
+   };
+
 class NameQualificationInheritedAttribute
    {
      private:
@@ -100,6 +139,9 @@ class NameQualificationTraversal : public AstTopDownBottomUpProcessing<NameQuali
        // specified. I think this only happens for the index in the SgArrayType.
           SgScopeStatement* explictlySpecifiedCurrentScope;
 
+       // Qualifier strings shared by this traversal and its nested traversals (NULL disables caching).
+          NameQualificationQualifierCache* qualifierCache;
+
      public:
        // DQ (3/24/2016): Adding Robb's meageage mechanism (data member and function).
           static Sawyer::Message::Facility mlog;
@@ -251,9 +251,11 @@ public:
      *     at the specified OFFSET but not exceeding a specified VMSIZE.  If this number of bytes cannot be read from the file
      *     then an error is thrown.
      *
-     * @li @c FILENAME: Name of file to read. The file must be readable by the user and its contents are copied into the memory
-     *     map.  Once inside the memory map, the segment can be given any accessibility according to PERM.  The name of the
-     *     segment will be the non-directory part of the FILENAME (e.g., on POSIX systems, the part after the final slash).
+     * @li @c FILENAME: Name of file to read. The file must be readable by the user.  On POSIX systems a regular file is mapped
+     *     privately into memory (pages are loaded on demand and writes are never saved to the file) and any VMSIZE beyond the
+     *     end of the file data is a separate zero-filled segment; other files are copied into the memory map.  Once inside the
+     *     memory map, the segment can be given any accessibility according to PERM.  The name of the segment will be the
+     *     non-directory part of the FILENAME (e.g., on POSIX systems, the part after the final slash).
      *
      * @section exampes Examples
      *
@@ -345,7 +347,9 @@ public:
      *
      *  Searches for the bytes specified by @p sequence occuring within the specified @p interval.  If the @p interval is empty
      *  or the sequence cannot be found then nothing is returned. Otherwise, the virtual address for the start of the sequence
-     *  is returned. An empty sequence matches at the beginning of the @p interval. */
+     *  is returned. An empty sequence matches at the beginning of the @p interval.  Sequences can be any length.
+     *
+     *  To search for many sequences at once, use @ref rose::BinaryAnalysis::PatternFinder instead. */
     Sawyer::Optional<rose_addr_t> findSequence(const AddressInterval &interval, const std::vector<uint8_t> &sequence) const;
 
     /** Prints the contents of the map for debugging. The @p prefix string is added to the beginning of every line of output
@@ -86,12 +86,14 @@ public:
      *======================================================================================================================== */
 public:
     BinaryLoader()
-        : p_perform_dynamic_linking(false), p_perform_remap(true), p_perform_relocations(false)
+        : p_perform_dynamic_linking(false), p_perform_remap(true), p_perform_relocations(false),
+          p_parse_mode(SgAsmExecutableFileFormat::PARSE_EAGER)
         { init(); }
 
     BinaryLoader(const BinaryLoader &other)
         : p_perform_dynamic_linking(other.p_perform_dynamic_linking),
-          p_perform_remap(other.p_perform_remap), p_perform_relocations(other.p_perform_relocations) {
+          p_perform_remap(other.p_perform_remap), p_perform_relocations(other.p_perform_relocations),
+          p_parse_mode(other.p_parse_mode) {
         preloads = other.preloads;
         directories = other.directories;
     }
@@ -171,6 +173,15 @@ public:
     /** Returns whether this loader will perform the relocation step. See also, set_perform_relocations(). */
     bool get_perform_relocations() const { return p_perform_relocations; }
 
+    /** Set how shared objects parsed by the linking step are parsed.  In SgAsmExecutableFileFormat::PARSE_LAZY mode symbol
+     *  and relocation tables are parsed when first accessed.  In SgAsmExecutableFileFormat::PARSE_HEADERS_ONLY mode only the
+     *  file headers and section and segment tables are parsed, which is enough to map the file but not to find its
+     *  dependencies or apply relocations. */
+    void set_parse_mode(SgAsmExecutableFileFormat::ParseMode mode) { p_parse_mode = mode; }
+
+    /** Returns how this loader parses shared objects. See also, set_parse_mode(). */
+    SgAsmExecutableFileFormat::ParseMode get_parse_mode() const { return p_parse_mode; }
+
 
 
     
@@ -225,8 +236,10 @@ public:
     /** Class method to parse, map, link, and/or relocate all interpretations of the specified binary composite. This should
      *  only be called for an SgBinaryComposite object that has been created but for which no binary files have been parsed
      *  yet.  It's only called from sage_support.cpp by SgBinaryComposite::buildAST().  A BinaryLoader::Exception is thrown if
-     *  there's an error of some sort. */
-    static void load(SgBinaryComposite* composite, bool read_executable_file_format_only=false);
+     *  there's an error of some sort.  The @p parseMode determines how much of each container is parsed, and when; see
+     *  set_parse_mode(). */
+    static void load(SgBinaryComposite* composite, bool read_executable_file_format_only=false,
+                     SgAsmExecutableFileFormat::ParseMode parseMode=SgAsmExecutableFileFormat::PARSE_EAGER);
 
     /** Conditionally parse, map, link, and/or relocate the interpretation according to properties of this loader. If an error
      *  occurs, a BinaryLoader::Exception will be thrown.  The interpretation must be one that can be loaded by this loader as
@@ -289,8 +302,10 @@ public:
     /** Parses a single binary file. The file may be an executable, core dump, or shared library.  The machine instructions in
      *  the file are not parsed--only the binary container is parsed.  The new SgAsmGenericFile is added to the supplied
      *  binary @p composite and a new interpretation is created if necessary.  Dwarf debugging information is also parsed and
-     *  added to the AST if Dwarf support is enable and the information is present in the binary container. */
-    static SgAsmGenericFile *createAsmAST(SgBinaryComposite *composite, std::string filePath);
+     *  added to the AST if Dwarf support is enable and the information is present in the binary container, unless only the
+     *  headers are being parsed. */
+    static SgAsmGenericFile *createAsmAST(SgBinaryComposite *composite, std::string filePath,
+                                          SgAsmExecutableFileFormat::ParseMode parseMode=SgAsmExecutableFileFormat::PARSE_EAGER);
 
     /** Finds shared object dependencies of a single binary header.  Returns a list of dependencies, which are usually library
      *  names rather than actual files.  The library names can be turned into file names by calling find_so_file().  Only one
@@ -418,6 +433,7 @@ private:
     bool p_perform_dynamic_linking;
     bool p_perform_remap;
     bool p_perform_relocations;
+    SgAsmExecutableFileFormat::ParseMode p_parse_mode;
 };
 
 #endif /* ROSE_BINARYLOADER_H */
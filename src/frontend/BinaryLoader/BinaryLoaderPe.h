@@ -24,6 +24,10 @@ public:
     /** Returns sections in order of their definition in the PE Section Table. */
     virtual SgAsmGenericSectionPtrList get_remap_sections(SgAsmGenericHeader*);
 
+    /** Returns the DLLs named by the PE Import Directories.  Import sections whose parsing was deferred are parsed first,
+     *  since that's when their DLLs are added to the header. */
+    virtual std::vector<std::string> dependencies(SgAsmGenericHeader*);
+
     /** Windows-specific PE section alignment. */
     virtual MappingContribution align_values(SgAsmGenericSection*, MemoryMap*,
                                              rose_addr_t *malign_lo, rose_addr_t *malign_hi,
@@ -341,6 +341,12 @@ public:
     void insertSuccessor(rose_addr_t va, size_t nBits, EdgeType type=E_NORMAL, Confidence confidence=ASSUMED);
     /** @} */
 
+    /** Replace all successors.
+     *
+     *  Caches the specified list as the complete set of successors, replacing any previous list.  An empty list means the
+     *  block is known to have no successors, which is different than @ref clearSuccessors. */
+    void successors(const Successors &successors) { successors_ = successors; }
+
     /** Clear all successor information. */
     void clearSuccessors();
 
@@ -259,6 +259,9 @@ struct PartitionerSettings {
  *  descriptions and command-line parser for these switches can be obtained from @ref engineBehaviorSwitches. */
 struct EngineSettings {
     std::vector<std::string> configurationNames;    /**< List of configuration files and/or directories. */
+    std::string resultCacheDirectory;               /**< Directory for caching partitioning results between runs. If empty
+                                                     *   then results are neither loaded from nor saved to a cache. See
+                                                     *   @ref ResultCache. */
 };
 
 // Additional declarations w/out definitions yet.
@@ -297,7 +297,9 @@ public:
      *
      *  @li Create a partitioner by calling @ref createPartitioner.
      *
-     *  @li Run the partitioner by calling @ref runPartitioner.
+     *  @li If a @ref resultCacheDirectory is set and it holds results for the same specimen and configuration (see @ref
+     *      resultCacheConfiguration), then attach those results to the partitioner and run only the post-partitioning
+     *      analyses. Otherwise run the partitioner by calling @ref runPartitioner and save its results in the cache.
      *
      *  Returns the partitioner that was used and which contains the results.
      *
@@ -535,6 +537,15 @@ public:
      *  blocks to functions.  It is often overridden by subclasses. */
     virtual void runPartitioner(Partitioner&);
 
+    /** Describes the configuration for caching results.
+     *
+     *  Returns a string describing everything other than the specimen that influences the results of @ref runPartitioner: the
+     *  disassembler's architecture, word size, and byte order, the partitioner settings, and the partitioner's configuration.
+     *  The string is hashed with the memory map and the specimen files to form the @ref ResultCache key, so it must be the same
+     *  for every run and must not contain addresses or compiler-specific type names.  Subclasses that have additional settings
+     *  that affect partitioning, or that override @ref runPartitioner, should append a description of them. */
+    virtual std::string resultCacheConfiguration(const Partitioner&);
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Partitioner mid-level functions
@@ -1151,6 +1162,16 @@ public:
     std::vector<std::string>& configurationNames() /*final*/ { return settings_.engine.configurationNames; }
     /** @} */
 
+    /** Property: Directory for cached results.
+     *
+     *  If non-empty, then @ref partition loads results from this directory instead of recomputing them when the specimen and
+     *  configuration are unchanged, and saves newly computed results there. See @ref ResultCache.
+     *
+     * @{ */
+    const std::string& resultCacheDirectory() const /*final*/ { return settings_.engine.resultCacheDirectory; }
+    virtual void resultCacheDirectory(const std::string &s) { settings_.engine.resultCacheDirectory = s; }
+    /** @} */
+
     /** Property: Give names to constants.
      *
      *  If this property is set, then the partitioner calls @ref Modules::nameConstants as part of its final steps.
@@ -138,8 +138,10 @@ public:
     bool insertBasicBlock(rose_addr_t bblockVa) {
         ASSERT_forbid(isFrozen_);
         bool wasInserted = bblockVas_.insert(bblockVa).second;
-        if (wasInserted)
+        if (wasInserted) {
             clearCache();
+            stackDeltaAnalysis_.clearResults();         // results describe the old set of blocks
+        }
         return wasInserted;
     }
 
@@ -151,8 +153,10 @@ public:
     void eraseBasicBlock(rose_addr_t bblockVa) {        // no-op if not existing
         ASSERT_forbid(isFrozen_);
         ASSERT_forbid2(bblockVa==entryVa_, "function entry block cannot be removed");
-        clearCache();
-        bblockVas_.erase(bblockVa);
+        if (bblockVas_.erase(bblockVa)) {
+            clearCache();
+            stackDeltaAnalysis_.clearResults();         // results describe the old set of blocks
+        }
     }
 
     /** Returns data blocks owned by this function.  Returns the data blocks that are owned by this function in order of their
@@ -217,7 +221,9 @@ public:
      *
      *  This property holds the results from stack delta analysis. It contains the stack entry and exit values for each basic
      *  block computed from data flow, and the overall stack delta for the function. The analysis is not updated by this class;
-     *  objects of this class only store the results provided by something else.
+     *  objects of this class only store the results provided by something else. The results are cleared whenever basic blocks
+     *  are added to or removed from this function, so a later analysis does not reuse deltas computed for a different set of
+     *  blocks.
      *
      *  The @c hasResults and @c didConverge methods invoked on the return value will tell you whether an analysis has run and
      *  whether the results are valid, respectively.
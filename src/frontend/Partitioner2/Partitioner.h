@@ -1605,7 +1605,11 @@ public:
      *  basicBlockOptionalMayReturn invoked on the function's entry block. See that method for details. */
     Sawyer::Optional<bool> functionOptionalMayReturn(const Function::Ptr &function) const /*final*/;
 
-    /** Compute may-return analysis for all functions. */
+    /** Compute may-return analysis for all functions.
+     *
+     *  Functions are analyzed in parallel using the number of threads specified by the "--threads" command-line switch. The
+     *  function call graph's cycles are broken and then functions are processed so that callees are analyzed before their
+     *  callers. */
     void allFunctionMayReturn() const /*final*/;
 
     /** Calling convention analysis for one function.
@@ -0,0 +1,90 @@
+#ifndef ROSE_Partitioner2_ResultCache_H
+#define ROSE_Partitioner2_ResultCache_H
+
+#include <MemoryMap.h>
+#include <Partitioner2/Partitioner.h>
+
+#include <boost/filesystem.hpp>
+#include <string>
+
+namespace rose {
+namespace BinaryAnalysis {
+namespace Partitioner2 {
+
+/** Persistent cache of partitioning results.
+ *
+ *  A result cache is a directory containing one file per partitioned specimen. Each file holds the final state of a partitioner
+ *  in a compact binary form: address names, data blocks, the control flow graph (basic block instruction addresses and
+ *  successor edges, and placeholders), and functions with their basic blocks and data blocks. The address usage map is not
+ *  stored since it is rebuilt as the blocks and functions are attached.
+ *
+ *  Files are named by a key that is a hash of the specimen memory contents, the specimen files, and a description of the
+ *  configuration that produced the results (see @ref key).  Each file also records the format @ref VERSION and the key; a
+ *  file whose version or key doesn't match is ignored so that the caller recomputes and overwrites it.
+ *
+ *  Instructions are not stored. They are disassembled again from the specimen memory when the results are loaded, which is
+ *  much faster than discovering them since no searching is involved. Results of post-partitioning analyses (may-return, stack
+ *  delta, calling convention) are also not stored.
+ *
+ * @code
+ *  ResultCache cache("/var/cache/rose");
+ *  uint64_t key = ResultCache::key(map, interp, configuration);
+ *  if (!cache.load(key, partitioner)) {
+ *      engine.runPartitioner(partitioner);
+ *      cache.save(key, partitioner);
+ *  }
+ * @endcode */
+class ROSE_DLL_API ResultCache {
+public:
+    /** Version number of the file format.
+     *
+     *  This must be incremented whenever the file format changes, or whenever partitioning changes in a way that would make
+     *  previously cached results incorrect. */
+    static const unsigned VERSION = 1;
+
+private:
+    boost::filesystem::path directory_;
+
+public:
+    /** Construct a cache for the specified directory.
+     *
+     *  The directory is created when the first result is saved if it doesn't exist yet. */
+    explicit ResultCache(const boost::filesystem::path &directory)
+        : directory_(directory) {}
+
+    /** Property: Directory holding the cached results. */
+    const boost::filesystem::path& directory() const { return directory_; }
+
+    /** Compute a cache key.
+     *
+     *  Returns a hash of the addresses, permissions, and contents of all segments of the memory map, the entire contents of
+     *  every file of the interpretation (if not null), and the @p configuration string, which should describe everything
+     *  else that influences the partitioning results.  The files are needed because partitioning also uses container data
+     *  that isn't loaded into memory, such as symbol tables and import names; for instance, a stripped and an unstripped
+     *  specimen usually have the same memory but different results. */
+    static uint64_t key(const MemoryMap&, SgAsmInterpretation*, const std::string &configuration);
+
+    /** Name of the file that holds results for the specified key. */
+    boost::filesystem::path fileName(uint64_t key) const;
+
+    /** Load cached results.
+     *
+     *  If a valid file exists for the specified key then its contents are attached to the partitioner and true is
+     *  returned. The partitioner should be newly created for the same memory map and disassembler that were used to compute the
+     *  key. Returns false without modifying the partitioner if the file is missing, has the wrong version or key, or is
+     *  corrupt, or if its instructions can no longer be disassembled. */
+    bool load(uint64_t key, Partitioner&) const;
+
+    /** Save results.
+     *
+     *  Writes the partitioner's state to the file for the specified key, replacing any previous file. The file is written
+     *  under a temporary name and then renamed so that concurrent readers never see a partial file.  Returns false and emits
+     *  a warning if the file could not be written. */
+    bool save(uint64_t key, const Partitioner&) const;
+};
+
+} // namespace
+} // namespace
+} // namespace
+
+#endif
@@ -178,6 +178,9 @@ class AttachPreprocessingInfoTreeTrav
        // DQ (11/30/2008): Refactored code to isolate this from the inherited attribute evaluation.
        // static ROSEAttributesList* buildCommentAndCppDirectiveList ( SgFile *currentFilePtr, std::map<std::string,ROSEAttributesList*>* mapOfAttributes, bool use_Wave );
           ROSEAttributesList* buildCommentAndCppDirectiveList ( bool use_Wave, std::string currentFilename );
+
+       // Lex the comments and CPP directives of a file once per project (see -rose:cacheCommentsAndDirectives).
+          static ROSEAttributesList* getCachedPreprocessorDirectives ( const std::string & fileName );
    };
 
 #endif
@@ -1552,10 +1552,18 @@ ROSEAttributesList *getPreprocessorDirectives( std::string fileName )
           if ( iItr != mapFilenameToAttributes.end())
              {
             // std::cout << "Found requested file: " << fileName << " size: " << iItr->second->size() << std::endl; 
+            // Insert copies, since the caller attaches the elements of the returned list to the AST. The saved list
+            // is normally sorted by line number, in which case each copy is simply appended.
+               std::vector<PreprocessingInfo*> & infoList = preprocessorInfoList->getList();
+               infoList.reserve(iItr->second->size());
                for(std::vector<PreprocessingInfo*>::iterator jItr = iItr->second->getList().begin(); jItr != iItr->second->getList().end(); ++jItr)
                   {
                   // std::cout << "Inserting element" <<  (*jItr)->getString() << std::endl;
-                     preprocessorInfoList->insertElement(**jItr);
+                     PreprocessingInfo* info = new PreprocessingInfo(**jItr);
+                     if (infoList.empty() == true || infoList.back()->getLineNumber() <= info->getLineNumber())
+                          infoList.push_back(info);
+                       else
+                          preprocessorInfoList->insertElement(*info);
                   }
 
              }
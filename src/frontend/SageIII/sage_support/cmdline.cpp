@@ -1648,6 +1648,7 @@ StripRoseOptions (std::vector<std::string>& argv)
   // (1) Options WITHOUT an argument
   // Example: sla(argv, "-rose:", "($)", "(unparser)",1);
   sla(argv, "-rose:unparser:", "($)", "(clobber_input_file)",1);
+  sla(argv, "-rose:unparser:", "($)", "(buffered_output)",1);
 
   //
   // (2) Options WITH an argument
@@ -1676,6 +1677,7 @@ Process (SgProject* project, std::vector<std::string>& argv)
       std::cout << "[INFO] Processing Unparser commandline options" << std::endl;
 
   ProcessClobberInputFile(project, argv);
+  ProcessBufferedOutput(project, argv);
 }// ::Rose::Cmdline::Unparser::Process
 
 void
@@ -1702,6 +1704,30 @@ ProcessClobberInputFile (SgProject* project, std::vector<std::string>& argv)
   }
 }// ::Rose::Cmdline::Unparser::ProcessClobberInputFile
 
+void
+Rose::Cmdline::Unparser::
+ProcessBufferedOutput (SgProject* project, std::vector<std::string>& argv)
+{
+  bool has_buffered_output =
+      CommandlineProcessing::isOption(
+          argv,
+          Cmdline::Unparser::option_prefix,
+          "buffered_output",
+          Cmdline::REMOVE_OPTION_FROM_ARGV);
+
+  if (has_buffered_output)
+  {
+      if (SgProject::get_verbose() > 1)
+          std::cout << "[INFO] Turning on the Unparser's buffered output mode" << std::endl;
+
+      project->set_unparser__buffered_output(true);
+  }
+  else
+  {
+      project->set_unparser__buffered_output(false);
+  }
+}// ::Rose::Cmdline::Unparser::ProcessBufferedOutput
+
 //------------------------------------------------------------------------------
 //                                  Fortran
 //------------------------------------------------------------------------------
@@ -3155,6 +3181,15 @@ SgFile::usage ( int status )
 "     -rose:collectAllCommentsAndDirectives\n"
 "                             store all comments and CPP directives in header\n"
 "                             files into the AST\n"
+"     -rose:cacheCommentsAndDirectives\n"
+"                             lex each file (typically a header file included\n"
+"                             by several source files) for comments and CPP\n"
+"                             directives only once per project; not used with\n"
+"                             -rose:unparse_tokens\n"
+"     -rose:noNameQualificationCache\n"
+"                             build every name qualifier during unparsing\n"
+"                             instead of reusing qualifiers already built for\n"
+"                             the same scope (output is the same either way)\n"
 "     -rose:unparseHeaderFiles\n"
 "                             unparse all directly or indirectly modified\n"
 "                             header files\n"
@@ -3321,6 +3356,11 @@ SgFile::usage ( int status )
 "                               that with this option you use ROSE, and run your build\n"
 "                               system, sequentially.\n"
 "                               **CAUTION**RED*ALERT**CAUTION**\n"
+"     -rose:unparser:buffered_output\n"
+"                               generate each file in memory and write it to disk\n"
+"                               with a single write to a temporary file that is then\n"
+"                               renamed to the output file name, so that a partially\n"
+"                               written output file is never observed\n"
 "     -rose:unparse_line_directives\n"
 "                               unparse statements using #line directives with\n"
 "                               reference to the original file and line number\n"
@@ -5088,6 +5128,22 @@ SgFile::processRoseCommandLineOptions ( vector<string> & argv )
           set_collectAllCommentsAndDirectives(true);
         }
 
+  //
+  // cacheCommentsAndDirectives option: lex each file for comments and CPP directives only once per project.
+  //
+     if ( CommandlineProcessing::isOption(argv,"-rose:","(cacheCommentsAndDirectives)",true) == true )
+        {
+          set_cacheCommentsAndDirectives(true);
+        }
+
+  //
+  // noNameQualificationCache option: build every name qualifier string instead of reusing cached ones.
+  //
+     if ( CommandlineProcessing::isOption(argv,"-rose:","(noNameQualificationCache)",true) == true )
+        {
+          set_noNameQualificationCache(true);
+        }
+
      // negara1 (07/08/2011): Made unparsing of header files optional. 
      if ( CommandlineProcessing::isOption(argv,"-rose:","(unparseHeaderFiles)",true) == true )
         {
@@ -5596,6 +5652,8 @@ SgFile::stripRoseCommandLineOptions ( vector<string> & argv )
      optionCount = sla(argv, "-rose:", "($)", "(unparse_binary_file_format)",1);
 
      optionCount = sla(argv, "-rose:", "($)", "(collectAllCommentsAndDirectives)",1);
+     optionCount = sla(argv, "-rose:", "($)", "(cacheCommentsAndDirectives)",1);
+     optionCount = sla(argv, "-rose:", "($)", "(noNameQualificationCache)",1);
      optionCount = sla(argv, "-rose:", "($)", "(unparseHeaderFiles)",1);
      optionCount = sla(argv, "-rose:", "($)", "(skip_commentsAndDirectives)",1);
      optionCount = sla(argv, "-rose:", "($)", "(skipfinalCompileStep)",1);
@@ -83,6 +83,9 @@ namespace Cmdline {
 
     void
     ProcessClobberInputFile (SgProject* project, std::vector<std::string>& argv);
+
+    void
+    ProcessBufferedOutput (SgProject* project, std::vector<std::string>& argv);
   } // namespace ::Rose::Cmdline::Unparser
 
   namespace Fortran {
@@ -355,18 +355,19 @@ public:
          *  work list is empty (before of after the iteration). */
         bool runOneIteration() {
             using namespace Diagnostics;
+            Stream &debug = mlog[DEBUG];                // look up the stream once; testing it is cheap
             if (!workList_.isEmpty()) {
                 if (++nIterations_ > maxIterations_) {
                     throw NotConverging("data-flow max iterations reached"
                                         " (max=" + StringUtility::numberToString(maxIterations_) + ")");
                 }
                 size_t cfgVertexId = workList_.popFront();
-                if (mlog[DEBUG]) {
-                    mlog[DEBUG] <<"runOneIteration: vertex #" <<cfgVertexId <<"\n";
-                    mlog[DEBUG] <<"  remaining worklist is {";
+                if (debug) {
+                    debug <<"runOneIteration: vertex #" <<cfgVertexId <<"\n";
+                    debug <<"  remaining worklist is {";
                     BOOST_FOREACH (size_t id, workList_.items())
-                        mlog[DEBUG] <<" " <<id;
-                    mlog[DEBUG] <<" }\n";
+                        debug <<" " <<id;
+                    debug <<" }\n";
                 }
                 
                 ASSERT_require2(cfgVertexId < cfg_.nVertices(),
@@ -375,38 +376,38 @@ public:
                 StatePtr state = incomingState_[cfgVertexId];
                 ASSERT_not_null2(state,
                                  "initial state must exist for CFG vertex " + boost::lexical_cast<std::string>(cfgVertexId));
-                if (mlog[DEBUG]) {
+                if (debug) {
                     std::ostringstream ss;
                     ss <<*state;
-                    mlog[DEBUG] <<"  incoming state for vertex #" <<cfgVertexId <<"\n";
-                    mlog[DEBUG] <<StringUtility::prefixLines(ss.str(), "    ");
+                    debug <<"  incoming state for vertex #" <<cfgVertexId <<"\n";
+                    debug <<StringUtility::prefixLines(ss.str(), "    ");
                 }
 
                 state = outgoingState_[cfgVertexId] = xfer_(cfg_, cfgVertexId, state);
                 ASSERT_not_null2(state, "outgoing state not created for vertex "+boost::lexical_cast<std::string>(cfgVertexId));
-                if (mlog[DEBUG]) {
+                if (debug) {
                     std::ostringstream ss;
                     ss <<*state;
-                    mlog[DEBUG] <<"  outgoing state for vertex #" <<cfgVertexId <<"\n";
-                    mlog[DEBUG] <<StringUtility::prefixLines(ss.str(), "    ");
+                    debug <<"  outgoing state for vertex #" <<cfgVertexId <<"\n";
+                    debug <<StringUtility::prefixLines(ss.str(), "    ");
                 }
                 
                 // Outgoing state must be merged into the incoming states for the CFG successors.  Any such incoming state that
                 // is modified as a result will have its CFG vertex added to the work list.
-                SAWYER_MESG(mlog[DEBUG]) <<"  forwarding vertex #" <<cfgVertexId <<" output state to "
-                                         <<StringUtility::plural(vertex->nOutEdges(), "vertices", "vertex") <<"\n";
+                SAWYER_MESG(debug) <<"  forwarding vertex #" <<cfgVertexId <<" output state to "
+                                   <<StringUtility::plural(vertex->nOutEdges(), "vertices", "vertex") <<"\n";
                 BOOST_FOREACH (const typename CFG::Edge &edge, vertex->outEdges()) {
                     size_t nextVertexId = edge.target()->id();
                     StatePtr targetState = incomingState_[nextVertexId];
                     if (targetState==NULL) {
-                        SAWYER_MESG(mlog[DEBUG]) <<"    forwarded to vertex #" <<nextVertexId <<"\n";
+                        SAWYER_MESG(debug) <<"    forwarded to vertex #" <<nextVertexId <<"\n";
                         incomingState_[nextVertexId] = xfer_(state); // copy the state
                         workList_.pushBack(nextVertexId);
                     } else if (merge_(targetState, state)) { // merge state into targetState, return true if changed
-                        SAWYER_MESG(mlog[DEBUG]) <<"    merged with vertex #" <<nextVertexId <<" (which changed as a result)\n";
+                        SAWYER_MESG(debug) <<"    merged with vertex #" <<nextVertexId <<" (which changed as a result)\n";
                         workList_.pushBack(nextVertexId);
                     } else {
-                        SAWYER_MESG(mlog[DEBUG]) <<"     merged with vertex #" <<nextVertexId <<" (no change)\n";
+                        SAWYER_MESG(debug) <<"     merged with vertex #" <<nextVertexId <<" (no change)\n";
                     }
                 }
             }
@@ -0,0 +1,147 @@
+#ifndef ROSE_BinaryAnalysis_PatternFinder_H
+#define ROSE_BinaryAnalysis_PatternFinder_H
+
+#include <MemoryMap.h>
+
+namespace rose {
+namespace BinaryAnalysis {
+
+/** %Analysis to find many byte patterns at once.
+ *
+ *  This analysis searches specimen memory for all occurrences of any number of byte sequences (crypto constants, magic
+ *  numbers, function prologues, etc.) in a single pass. The patterns are compiled into an Aho-Corasick automaton, so the time
+ *  to search is proportional to the amount of memory searched plus the number of matches, regardless of the number of
+ *  patterns.  Bytes that cannot begin any pattern are skipped without consulting the automaton.
+ *
+ *  Memory is divided into chunks that are searched in parallel. Matches that span the boundary between two chunks, or
+ *  between two adjacent segments that both satisfy the search constraints, are found exactly once.  Matches never span a
+ *  segment boundary if the constraints are limited to a single segment.
+ *
+ * @code
+ *  using namespace rose::BinaryAnalysis;
+ *  PatternFinder finder;
+ *  size_t sha256 = finder.insert(std::vector<uint8_t>(sha256InitBytes, sha256InitBytes+32));
+ *  finder.insert("\x55\x89\xe5");                     // push ebp; mov ebp, esp
+ *  std::vector<PatternFinder::Match> matches = finder.search(map.require(MemoryMap::READABLE));
+ * @endcode */
+class ROSE_DLL_API PatternFinder {
+public:
+    /** Settings that control the search. */
+    struct Settings {
+        /** Number of threads.
+         *
+         *  Maximum number of worker threads used to search memory. Zero means use the hardware concurrency. The default is the
+         *  value of the global "--threads" command-line switch. */
+        size_t nThreads;
+
+        /** Size of each unit of work in bytes.
+         *
+         *  Searchable memory is divided into chunks of about this size which are distributed among the worker threads. */
+        size_t chunkSize;
+
+        Settings();
+    };
+
+    /** A pattern found in memory. */
+    struct Match {
+        size_t patternId;                               /**< ID number returned when the pattern was inserted. */
+        rose_addr_t va;                                 /**< Address of the first byte of the match. */
+
+        Match(): patternId(0), va(0) {}
+        Match(size_t patternId, rose_addr_t va): patternId(patternId), va(va) {}
+
+        /** Orders matches by address, then pattern ID. */
+        bool operator<(const Match &other) const {
+            return va < other.va || (va == other.va && patternId < other.patternId);
+        }
+    };
+
+    /** Functor invoked for each match.
+     *
+     *  The callback is invoked once per match while the search is in progress.  Invocations are serialized, so the callback
+     *  need not be thread-safe, but they are not in any particular address order.  If the callback returns false then the
+     *  search stops as soon as possible, although a few more matches may still be reported. */
+    class Callback {
+    public:
+        virtual ~Callback() {}
+        virtual bool operator()(const PatternFinder&, const Match&) = 0;
+    };
+
+private:
+    // Node of the Aho-Corasick trie. The transitions are sorted by byte value.
+    struct State {
+        std::vector<std::pair<uint8_t, size_t> > next;  // goto function
+        size_t failure;                                 // longest proper suffix that is also a trie prefix
+        size_t output;                                  // nearest state on the failure chain that ends some pattern, or zero
+        std::vector<size_t> patternIds;                 // patterns that end at this state
+        State(): failure(0), output(0) {}
+    };
+
+    Settings settings_;
+    std::vector<std::vector<uint8_t> > patterns_;       // patterns indexed by ID
+    std::vector<State> states_;                         // state zero is the root
+    size_t rootNext_[256];                              // dense goto function for the root state
+    bool isStart_[256];                                 // bytes that begin at least one pattern
+    size_t maxPatternSize_;                             // length of longest pattern
+    bool isCompiled_;                                   // failure and output functions are up to date
+
+public:
+    /** Constructs a finder with no patterns. */
+    PatternFinder() { clear(); }
+
+    /** Property: Settings.
+     *
+     * @{ */
+    const Settings& settings() const { return settings_; }
+    Settings& settings() { return settings_; }
+    /** @} */
+
+    /** Insert a pattern.
+     *
+     *  Adds the pattern to the set of patterns being searched and returns the pattern's ID number. IDs are assigned
+     *  consecutively starting at zero.  Empty patterns are allowed but never match anything.
+     *
+     * @{ */
+    size_t insert(const std::vector<uint8_t> &pattern);
+    size_t insert(const std::string &pattern);
+    /** @} */
+
+    /** Number of patterns. */
+    size_t nPatterns() const { return patterns_.size(); }
+
+    /** Pattern with the specified ID. */
+    const std::vector<uint8_t>& pattern(size_t id) const;
+
+    /** Remove all patterns. */
+    void clear();
+
+    /** Search memory for all patterns.
+     *
+     *  Searches the parts of memory described by the constraints (address limits, segment permissions, segment name
+     *  substring, segment predicates, and whether matches may cross segment boundaries) and reports each match to the @p
+     *  callback.  The constraints' size limit is ignored. Returns the number of matches reported.  The vector-returning
+     *  version collects all matches and returns them sorted by address and pattern ID.
+     *
+     * @{ */
+    size_t search(const MemoryMap::ConstConstraints&, Callback&);
+    std::vector<Match> search(const MemoryMap::ConstConstraints&);
+    /** @} */
+
+private:
+    struct Searcher;
+    friend struct Searcher;
+
+    // Compute failure and output functions after patterns are inserted.
+    void compile();
+
+    // Goto function for non-root states, or zero if there is no transition.
+    size_t gotoState(size_t state, uint8_t byte) const;
+
+    // Next state after consuming a byte.
+    size_t nextState(size_t state, uint8_t byte) const;
+};
+
+} // namespace
+} // namespace
+
+#endif
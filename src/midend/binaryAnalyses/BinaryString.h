@@ -392,6 +392,12 @@ public:
     virtual State decode(Octet) ROSE_OVERRIDE;
     virtual CodeValue consume() ROSE_OVERRIDE;
     virtual void reset() ROSE_OVERRIDE;
+
+    /** Number of octets per code value. */
+    size_t octetsPerValue() const { return octetsPerValue_; }
+
+    /** Order of the octets within a multi-octet code value. */
+    ByteOrder::Endianness byteOrder() const { return sex_; }
 };
 
 /** Returns a new basic character encoding scheme. */
@@ -840,9 +846,25 @@ public:
          *  length, then removes any string whose memory addresses overlap with any prior string in the list. */
         bool keepingOnlyLongest;
 
-        Settings(): minLength(5), maxLength(-1), maxOverlap(8), keepingOnlyLongest(true) {}
+        /** Number of threads.
+         *
+         *  Maximum number of worker threads used to search memory. Zero means use the hardware concurrency. The default is the
+         *  value of the global "--threads" command-line switch. */
+        size_t nThreads;
+
+        Settings();
     };
-    
+
+    /** Functor invoked for each string that is found.
+     *
+     *  See @ref find. Invocations are serialized, so the callback need not be thread-safe. If the callback returns false then
+     *  the search stops as soon as possible, although a few more strings may still be reported. */
+    class Callback {
+    public:
+        virtual ~Callback() {}
+        virtual bool operator()(const StringFinder&, const EncodedString&) = 0;
+    };
+
 private:
     Settings settings_;                                 // command-line settings for this analysis
     bool discardingCodePoints_;                         // whether to store decoded code points
@@ -951,9 +973,23 @@ public:
      *  sf.settings().maxLength = 31;
      *  sf.settings().allowOverlap = false;
      *  std::vector<EncodedString> strings = sf.find(map.require(MemoryMap::READABLE).prohibit(MemoryMap::WRITABLE)).strings();
-     * @endcode */
+     * @endcode
+     *
+     *  Memory is divided into parts that are searched in parallel (see @ref Settings::nThreads). NUL-terminated printable ASCII
+     *  strings whose characters are stored in one, two, or four octets in either byte order (ASCII, UTF-16, UTF-32), or as
+     *  UTF-8, are decoded by a fast path that skips over octets that cannot start a string; other encoders, anchored
+     *  searches, and a zero minimum length use the general decoders. The results, and their order, are the same either
+     *  way. */
     StringFinder& find(const MemoryMap::ConstConstraints&, Sawyer::Container::MatchFlags flags=0);
 
+    /** Finds strings and reports them to a callback.
+     *
+     *  This is like the other @ref find method except that strings are reported to the @p callback as they are found (in no
+     *  particular order) rather than being stored in this analysis, and the @ref Settings::keepingOnlyLongest setting is not
+     *  applied since that requires all strings to be known. This is useful when searching very large memory maps. The
+     *  previous results, if any, are not changed. Returns the number of strings reported. */
+    size_t find(const MemoryMap::ConstConstraints&, Callback&, Sawyer::Container::MatchFlags flags=0) const;
+
     /** Obtain strings that were found.
      *
      * @{ */
@@ -0,0 +1,175 @@
+#ifndef ROSE_BinaryAnalysis_SymbolicExprEvaluator_H
+#define ROSE_BinaryAnalysis_SymbolicExprEvaluator_H
+
+#include <BinarySymbolicExpr.h>
+#include <Sawyer/Map.h>
+#include <Sawyer/Optional.h>
+
+namespace rose {
+namespace BinaryAnalysis {
+
+/** Evaluates a symbolic expression over many concrete inputs.
+ *
+ *  Some analyses evaluate one symbolic expression for thousands of different variable assignments. Doing that by substituting
+ *  constants for the variables and letting the simplifier fold the result creates and simplifies a new expression tree for
+ *  every input.  This class instead compiles the expression once into a linear program (one instruction per unique node of
+ *  the expression DAG) and then runs that program over batches of inputs.
+ *
+ *  Inputs and outputs are in structure-of-arrays form: there is one column of values per variable, and the i'th element of
+ *  each column together form the i'th input. The program is run over @ref BATCH_SIZE inputs at a time, one instruction at a
+ *  time, and each instruction is a simple loop over the inputs of the batch, which the compiler is able to vectorize.
+ *
+ *  All values, including the result and all intermediate values, must be 64 bits or narrower. Values are stored in the low
+ *  order bits of a @c uint64_t with the high order bits cleared, the same as @ref SymbolicExpr::Node::toInt.
+ *
+ *  The supported operators are the bit-vector arithmetic, bitwise, shift, rotate, comparison, extension, extract, concat and
+ *  if-then-else operators. Division, modulus, memory, and set operators are not supported and cause @ref compile to throw an
+ *  @ref Exception, as do extract operators whose bit limits are not constants.
+ *
+ * @code
+ *  SymbolicExpr::Ptr expr = ...;
+ *  SymbolicExprEvaluator evaluator(expr);
+ *  size_t n = ...;                                     // number of inputs
+ *  std::vector<std::vector<uint64_t> > inputs(evaluator.variables().size(), std::vector<uint64_t>(n));
+ *  ...                                                 // fill in inputs[variable][input]
+ *  std::vector<uint64_t> results = evaluator.evaluate(inputs);
+ * @endcode */
+class SymbolicExprEvaluator {
+public:
+    /** Errors thrown by the compiler. */
+    class Exception: public std::runtime_error {
+    public:
+        explicit Exception(const std::string &mesg): std::runtime_error(mesg) {}
+        ~Exception() throw () {}
+    };
+
+    /** Instruction operation codes. */
+    enum Opcode {
+        I_CONSTANT,                                     /**< Result is @c imm. */
+        I_VARIABLE,                                     /**< Result is input column number @c imm. */
+        I_ADD,                                          /**< Sum of @c a and @c b. */
+        I_AND,                                          /**< Bitwise AND of @c a and @c b. */
+        I_OR,                                           /**< Bitwise OR of @c a and @c b. */
+        I_XOR,                                          /**< Bitwise XOR of @c a and @c b. */
+        I_INVERT,                                       /**< Bitwise complement of @c a. */
+        I_NEGATE,                                       /**< Two's complement of @c a. */
+        I_UMUL,                                         /**< Unsigned product of @c a and @c b. */
+        I_SMUL,                                         /**< Signed product of @c a and @c b. */
+        I_SHL0,                                         /**< Shift @c b left by @c a bits introducing zeros. */
+        I_SHL1,                                         /**< Shift @c b left by @c a bits introducing ones. */
+        I_SHR0,                                         /**< Shift @c b right by @c a bits introducing zeros. */
+        I_SHR1,                                         /**< Shift @c b right by @c a bits introducing ones. */
+        I_ASR,                                          /**< Shift @c b right by @c a bits replicating the sign bit. */
+        I_ROL,                                          /**< Rotate @c b left by @c a bits. */
+        I_ROR,                                          /**< Rotate @c b right by @c a bits. */
+        I_EXTRACT,                                      /**< Bits of @c a starting at bit @c imm. */
+        I_CONCAT,                                       /**< @c a in the high-order bits, @c b in the low-order @c imm bits. */
+        I_UEXTEND,                                      /**< Zero extend or truncate @c a. */
+        I_SEXTEND,                                      /**< Sign extend or truncate @c a. */
+        I_ITE,                                          /**< If @c a then @c b else @c c. */
+        I_EQ,                                           /**< Whether @c a equals @c b. */
+        I_NE,                                           /**< Whether @c a differs from @c b. */
+        I_ULT,                                          /**< Unsigned less-than. */
+        I_ULE,                                          /**< Unsigned less-than-or-equal. */
+        I_UGT,                                          /**< Unsigned greater-than. */
+        I_UGE,                                          /**< Unsigned greater-than-or-equal. */
+        I_SLT,                                          /**< Signed less-than. */
+        I_SLE,                                          /**< Signed less-than-or-equal. */
+        I_SGT,                                          /**< Signed greater-than. */
+        I_SGE,                                          /**< Signed greater-than-or-equal. */
+        I_ZEROP,                                        /**< Whether @c a is zero. */
+        I_LSSB,                                         /**< Index of least significant set bit of @c a, or zero. */
+        I_MSSB                                          /**< Index of most significant set bit of @c a, or zero. */
+    };
+
+    /** One instruction.
+     *
+     *  Each instruction computes one value that's @c nBits wide. The operands @c a, @c b, and @c c are the indexes of
+     *  earlier instructions whose values are used as arguments. Operand widths are the widths of those instructions. */
+    struct Instruction {
+        Opcode opcode;                                  /**< Operation to perform. */
+        size_t nBits;                                   /**< Width of the result. */
+        size_t a, b, c;                                 /**< Operands, depending on the opcode. */
+        uint64_t imm;                                   /**< Immediate value, depending on the opcode. */
+        Instruction(Opcode opcode, size_t nBits, size_t a=0, size_t b=0, size_t c=0, uint64_t imm=0)
+            : opcode(opcode), nBits(nBits), a(a), b(b), c(c), imm(imm) {}
+    };
+
+    /** Number of inputs evaluated together. */
+    static const size_t BATCH_SIZE = 64;
+
+private:
+    std::vector<Instruction> code_;
+    std::vector<SymbolicExpr::LeafPtr> variables_;      // one per input column, sorted by variable name
+    Sawyer::Container::Map<uint64_t, size_t> columns_;  // column number for each variable name
+
+public:
+    /** Construct an evaluator with no program. */
+    SymbolicExprEvaluator() {}
+
+    /** Construct an evaluator for an expression.
+     *
+     *  This is the same as default-constructing an evaluator and then calling @ref compile. */
+    explicit SymbolicExprEvaluator(const SymbolicExpr::Ptr &expr) {
+        compile(expr);
+    }
+
+    /** Compile an expression.
+     *
+     *  Replaces the evaluator's program with one that computes the specified expression. Throws an @ref Exception if the
+     *  expression uses an unsupported operator or has values wider than 64 bits, in which case the evaluator is left empty. */
+    void compile(const SymbolicExpr::Ptr&);
+
+    /** Whether the evaluator has a program. */
+    bool isEmpty() const { return code_.empty(); }
+
+    /** The compiled program.
+     *
+     *  The last instruction computes the value of the whole expression. */
+    const std::vector<Instruction>& code() const { return code_; }
+
+    /** Variables that are inputs to the program.
+     *
+     *  Each variable corresponds to one column of input, in the order returned. Variables are sorted by name (see @ref
+     *  SymbolicExpr::Leaf::nameId) and each variable appears once no matter how many times it occurs in the expression. */
+    const std::vector<SymbolicExpr::LeafPtr>& variables() const { return variables_; }
+
+    /** Input column for a variable.
+     *
+     *  Returns the column for the specified variable, or nothing if the variable is not an input to the program. */
+    Sawyer::Optional<size_t> column(const SymbolicExpr::LeafPtr&) const;
+
+    /** Width of the result in bits. */
+    size_t nBits() const;
+
+    /** Evaluate for many inputs.
+     *
+     *  The @p columns argument has one pointer per @ref variables, each pointing to @p nInputs values for that variable. Only
+     *  the low order bits of each input are used, as many as the variable's width. The results are written to @p results,
+     *  which must have room for @p nInputs values.
+     *
+     * @{ */
+    void evaluate(const std::vector<const uint64_t*> &columns, size_t nInputs, uint64_t *results) const;
+    std::vector<uint64_t> evaluate(const std::vector<std::vector<uint64_t> > &columns) const;
+    /** @} */
+
+    /** Evaluate for one input.
+     *
+     *  The argument has one value per @ref variables. */
+    uint64_t evaluateOne(const std::vector<uint64_t> &values) const;
+
+    /** Print the program. */
+    void print(std::ostream&) const;
+
+private:
+    size_t compileNode(const SymbolicExpr::Ptr&, Sawyer::Container::Map<SymbolicExpr::Node*, size_t> &compiled);
+    size_t emit(const Instruction&);
+    size_t emitChain(Opcode, const SymbolicExpr::InteriorPtr&, const std::vector<size_t> &args);
+};
+
+std::ostream& operator<<(std::ostream&, const SymbolicExprEvaluator&);
+
+} // namespace
+} // namespace
+
+#endif
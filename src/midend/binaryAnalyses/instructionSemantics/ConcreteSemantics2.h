@@ -10,6 +10,7 @@
 #include "BaseSemantics2.h"
 #include "RegisterStateGeneric.h"
 #include <Sawyer/BitVector.h>
+#include <Sawyer/Map.h>
 
 namespace rose {
 namespace BinaryAnalysis {              // documented elsewhere
@@ -160,22 +161,40 @@ typedef boost::shared_ptr<class MemoryState> MemoryStatePtr;
 /** Byte-addressable memory.
  *
  *  This class represents an entire state of memory via MemoryMap, allocating new memory in units of pages (the size of a page
- *  is configurable. */
+ *  is configurable.
+ *
+ *  A memory state can save a checkpoint and later be rolled back to it (see @ref checkpoint and @ref restore). Nothing is
+ *  copied when the checkpoint is made; instead, the first time each page is modified after the checkpoint its old contents are
+ *  saved, so rolling back costs time proportional to the number of pages that were modified (the "dirty" pages) rather than
+ *  the size of memory. */
 class MemoryState: public BaseSemantics::MemoryState {
     MemoryMap map_;
     rose_addr_t pageSize_;
 
+    // Contents of a page before it was first modified after the checkpoint.
+    struct SavedPage {
+        bool mapped;                                    // whether the page existed at the time of the checkpoint
+        std::vector<uint8_t> data;                      // old contents if the page existed
+        SavedPage(): mapped(false) {}
+    };
+    typedef Sawyer::Container::Map<rose_addr_t, SavedPage> SavedPages;
+
+    bool hasCheckpoint_;                                // whether a checkpoint is active
+    SavedPages savedPages_;                             // dirty pages indexed by page address
+    Sawyer::Optional<MemoryMap> savedMap_;              // entire map if it was replaced since the checkpoint
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Real constructors
 protected:
     explicit MemoryState(const BaseSemantics::SValuePtr &addrProtoval, const BaseSemantics::SValuePtr &valProtoval)
-        : BaseSemantics::MemoryState(addrProtoval, valProtoval), pageSize_(4096) {
+        : BaseSemantics::MemoryState(addrProtoval, valProtoval), pageSize_(4096), hasCheckpoint_(false) {
         (void) SValue::promote(addrProtoval);           // for its checking side effects
         (void) SValue::promote(valProtoval);
     }
 
+    // The copy has no checkpoint, even if the source does.
     MemoryState(const MemoryState &other)
-        : BaseSemantics::MemoryState(other), map_(other.map_), pageSize_(other.pageSize_) {
+        : BaseSemantics::MemoryState(other), map_(other.map_), pageSize_(other.pageSize_), hasCheckpoint_(false) {
         BOOST_FOREACH (MemoryMap::Segment &segment, map_.values())
             segment.buffer()->copyOnWrite(true);
     }
@@ -233,9 +252,7 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Methods we inherited
 public:
-    virtual void clear() {
-        map_.clear();
-    }
+    virtual void clear() ROSE_OVERRIDE;
 
     virtual void print(std::ostream&, Formatter&) const;
 
@@ -252,7 +269,9 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Methods first declared in this class
 public:
-    /** Returns the memory map. */
+    /** Returns the memory map.
+     *
+     *  Writing to the map's buffers directly bypasses the checkpoint, so such changes are not undone by @ref restore. */
     const MemoryMap& memoryMap() const { return map_; }
 
     /** Set memory map.
@@ -262,6 +281,37 @@ public:
      *  the memory region being padded.  All padding segments will be named "padding". */
     void memoryMap(const MemoryMap&, Sawyer::Optional<unsigned> padAccess = Sawyer::Nothing());
 
+    /** Save a checkpoint.
+     *
+     *  Subsequent changes to this memory state can be undone by calling @ref restore.  Any previous checkpoint is discarded.
+     *  This is a constant-time operation. */
+    void checkpoint();
+
+    /** Roll back to the checkpoint.
+     *
+     *  Restores the contents of memory to what they were when @ref checkpoint was called, discarding pages that were allocated
+     *  since then. The checkpoint remains active, so the same state can be restored repeatedly. The cost is proportional to the
+     *  number of dirty pages.  It is an error to call this if there is no checkpoint. */
+    void restore();
+
+    /** Discard the checkpoint.
+     *
+     *  Changes can no longer be undone, and memory is no longer tracked for dirty pages. */
+    void discardCheckpoint();
+
+    /** Whether a checkpoint is active. */
+    bool hasCheckpoint() const { return hasCheckpoint_; }
+
+    /** Addresses of dirty pages.
+     *
+     *  Returns the starting address of each page that has been modified or allocated since the checkpoint, in ascending
+     *  order. Pages are not tracked after the entire memory map is replaced (e.g., by @ref clear) since @ref restore then
+     *  reinstates the old map as a whole. */
+    std::vector<rose_addr_t> dirtyPages() const;
+
+    /** Number of dirty pages. See @ref dirtyPages. */
+    size_t nDirtyPages() const { return savedPages_.size(); }
+
     /** Size of each page of memory.
      *
      *  Memory is allocated in units of the page size and aligned on page-size boundaries.  The page size cannot be changed
@@ -278,6 +328,12 @@ public:
      *  is already allocated unless: it will replace the allocated page with a new one containing all zeros. */
     void allocatePage(rose_addr_t va);
 
+protected:
+    // Saves the page containing the specified address if this is its first modification since the checkpoint.
+    void saveDirtyPage(rose_addr_t va);
+
+    // Saves the entire map if it's about to be replaced, since the pages no longer describe it.
+    void saveMap();
 };
 
 
@@ -314,6 +370,8 @@ typedef boost::shared_ptr<class RiscOperators> RiscOperatorsPtr;
  * @endcode
  */
 class RiscOperators: public BaseSemantics::RiscOperators {
+    BaseSemantics::RegisterStatePtr checkpointRegisters_; // registers saved by checkpoint()
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Real constructors
 protected:
@@ -379,6 +437,33 @@ public:
         return retval;
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Checkpoints, for running many inputs from a common starting state.
+public:
+    /** Save a checkpoint of the current state.
+     *
+     *  Saves a copy of the registers and starts tracking dirty pages in memory (see @ref MemoryState::checkpoint). A later call
+     *  to @ref restore returns the current state to this point, which is much cheaper than creating a new state from the
+     *  specimen since only the memory pages that were modified are copied back.  Any previous checkpoint is discarded. The
+     *  current state must have a ConcreteSemantics memory state. */
+    void checkpoint();
+
+    /** Roll back to the checkpoint.
+     *
+     *  Returns the registers and memory of the current state to what they were when @ref checkpoint was called. The current
+     *  state object itself is not replaced. The checkpoint remains active. */
+    void restore();
+
+    /** Whether a checkpoint is active. */
+    bool hasCheckpoint() const { return checkpointRegisters_ ? true : false; }
+
+    /** Fork these operators.
+     *
+     *  Returns new operators whose current state is a copy of this object's current state, so emulation can continue along
+     *  several paths from a common prefix. Memory is copied lazily: the buffers are shared copy-on-write (see @ref
+     *  MemoryState::clone). The new operators have no checkpoint. */
+    RiscOperatorsPtr fork() const;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // New methods for constructing values, so we don't have to write so many SValue::promote calls in the RiscOperators
     // implementations.
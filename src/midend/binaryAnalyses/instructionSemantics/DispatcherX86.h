@@ -2,6 +2,9 @@
 #define ROSE_DispatcherX86_H
 
 #include "BaseSemantics2.h"
+#include "MicroOpSemantics2.h"
+
+#include <Sawyer/Map.h>
 
 namespace rose {
 namespace BinaryAnalysis {
@@ -16,23 +19,43 @@ namespace InstructionSemantics2 {
 typedef boost::shared_ptr<class DispatcherX86> DispatcherX86Ptr;
 
 class DispatcherX86: public BaseSemantics::Dispatcher {
+public:
+    /** Counters for the translation cache. See @ref translationCache. */
+    struct TranslationStatistics {
+        size_t nReplayed;                               /**< Instructions processed by replaying a trace. */
+        size_t nTranslated;                             /**< Traces created. */
+        size_t nUntranslatable;                         /**< Instructions that could not be translated. */
+        size_t nInvalidated;                            /**< Traces discarded because the instruction bytes changed. */
+        TranslationStatistics(): nReplayed(0), nTranslated(0), nUntranslatable(0), nInvalidated(0) {}
+    };
+
 protected:
     X86InstructionSize processorMode_;
 
+    // Translation cache. An entry with a null trace is an instruction that could not be translated; it's kept so that the
+    // translation is not attempted each time the instruction is processed.
+    typedef Sawyer::Container::Map<rose_addr_t, MicroOpSemantics::TracePtr> Translations;
+    bool translationCache_;                             // whether processInstruction uses the cache
+    Translations translations_;                         // traces indexed by instruction address
+    MicroOpSemantics::RiscOperatorsPtr recorder_;       // recording operators, created on first use
+    bool recording_;                                    // true while an instruction is being translated
+    std::vector<BaseSemantics::SValuePtr> replaySlots_; // scratch space for Trace::replay
+    TranslationStatistics translationStats_;
+
     // Prototypical constructor
     DispatcherX86()
         : BaseSemantics::Dispatcher(32, SgAsmX86Instruction::registersForInstructionSize(x86_insnsize_32)),
-          processorMode_(x86_insnsize_32) {}
+          processorMode_(x86_insnsize_32), translationCache_(false), recording_(false) {}
 
     // Prototypical constructor
     DispatcherX86(size_t addrWidth, const RegisterDictionary *regs/*=NULL*/)
         : BaseSemantics::Dispatcher(addrWidth, regs ? regs : SgAsmX86Instruction::registersForWidth(addrWidth)),
-          processorMode_(SgAsmX86Instruction::instructionSizeForWidth(addrWidth)) {}
+          processorMode_(SgAsmX86Instruction::instructionSizeForWidth(addrWidth)), translationCache_(false), recording_(false) {}
 
     // Normal constructor
     DispatcherX86(const BaseSemantics::RiscOperatorsPtr &ops, size_t addrWidth, const RegisterDictionary *regs)
         : BaseSemantics::Dispatcher(ops, addrWidth, regs ? regs : SgAsmX86Instruction::registersForWidth(addrWidth)),
-          processorMode_(SgAsmX86Instruction::instructionSizeForWidth(addrWidth)) {
+          processorMode_(SgAsmX86Instruction::instructionSizeForWidth(addrWidth)), translationCache_(false), recording_(false) {
         regcache_init();
         iproc_init();
         memory_init();
@@ -120,9 +143,49 @@ public:
      *
      * @{ */
     X86InstructionSize processorMode() const { return processorMode_; }
-    void processorMode(X86InstructionSize m) { processorMode_ = m; }
+    void processorMode(X86InstructionSize m) { processorMode_ = m; clearTranslationCache(); }
+    /** @} */
+
+    /** Property: whether to cache translated instruction semantics.
+     *
+     *  When enabled, the first time an instruction is processed its semantics are recorded as a @ref MicroOpSemantics::Trace
+     *  (a linear list of RISC operator calls) which is then replayed against this dispatcher's RISC operators.  Each later
+     *  time an instruction with the same address and bytes is processed, the trace is replayed directly, skipping the operand
+     *  decoding and the instruction processor.  The RISC operators see exactly the same sequence of calls in both cases.
+     *
+     *  Traces are keyed by instruction address and checked against the instruction bytes before they're used, so
+     *  self-modifying code causes retranslation rather than stale semantics.  Instructions whose semantics depend on the
+     *  values being computed (e.g., a repeat count or a divisor that the dispatcher inspects) cannot be translated and are
+     *  always processed the normal way.
+     *
+     *  The cache is disabled by default.  It is cleared when it's disabled, and whenever something that affects translation
+     *  changes: the processor mode, the register dictionary, or an instruction processor.
+     *
+     * @{ */
+    bool translationCache() const { return translationCache_; }
+    void translationCache(bool b);
+    /** @} */
+
+    /** Discard all cached translations. */
+    void clearTranslationCache();
+
+    /** Discard cached translations for instructions that start in the specified address range.  Since instructions can be up
+     *  to 15 bytes, callers that write to memory should start the range 14 bytes before the first byte written. */
+    void invalidateTranslations(rose_addr_t va, size_t nBytes);
+
+    /** Number of cached translations, including those recorded as untranslatable. */
+    size_t nTranslations() const { return translations_.size(); }
+
+    /** Translation cache counters.
+     *
+     * @{ */
+    const TranslationStatistics& translationStatistics() const { return translationStats_; }
+    void resetTranslationStatistics() { translationStats_ = TranslationStatistics(); }
     /** @} */
 
+    virtual void processInstruction(SgAsmInstruction *insn) ROSE_OVERRIDE;
+    virtual void advanceInstructionPointer(SgAsmInstruction*) ROSE_OVERRIDE;
+    virtual void iproc_set(int key, BaseSemantics::InsnProcessor *iproc) ROSE_OVERRIDE;
     virtual void set_register_dictionary(const RegisterDictionary *regdict) ROSE_OVERRIDE;
 
     /** Get list of common registers. Returns a list of non-overlapping registers composed of the largest registers except
@@ -242,6 +305,10 @@ public:
     /** Convert an unsigned value to a narrower unsigned type.  Returns the truncated source value except when the value cannot
      * be represented by the narrower type, in which case the closest unsigned value is returned. */
     virtual BaseSemantics::SValuePtr saturateUnsignedToUnsigned(const BaseSemantics::SValuePtr&, size_t narrowerWidth);
+
+protected:
+    /** Record the semantics of an instruction. Returns null if the instruction cannot be translated. */
+    MicroOpSemantics::TracePtr translate(SgAsmInstruction*);
 };
         
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,655 @@
+#ifndef Rose_FastConcreteSemantics2_H
+#define Rose_FastConcreteSemantics2_H
+
+#include "BaseSemantics2.h"
+#include "ConcreteSemantics2.h"
+#include <Sawyer/BitVector.h>
+#include <Sawyer/Map.h>
+
+namespace rose {
+namespace BinaryAnalysis {              // documented elsewhere
+namespace InstructionSemantics2 {       // documented elsewhere
+
+/** A concrete semantic domain tuned for emulation speed.
+ *
+ *  This domain computes the same results as @ref ConcreteSemantics but is organized for throughput when emulating long
+ *  instruction sequences:
+ *
+ *  @li Values that are 64 bits or narrower are stored directly as a 64-bit integer instead of in a bit vector, so creating
+ *      a value is one small-object allocation and the RISC operators are ordinary integer arithmetic.  Wider values (e.g., XMM
+ *      registers, 128-bit products) are stored in a bit vector and their operations are delegated to @ref
+ *      ConcreteSemantics.
+ *
+ *  @li Registers are stored in a flat array of words indexed by the register's major and minor numbers, so reading or writing
+ *      a register is an array lookup and a shift instead of a search through a list of stored register parts.
+ *
+ *  @li Memory is a table of fixed-size pages in front of a @ref MemoryMap that provides the initial contents. Recently used
+ *      pages are found through a small direct-mapped cache, and multi-byte reads and writes are copied in one step instead of
+ *      one byte at a time.
+ *
+ *  The domain implements the same interfaces as every other domain, so it can be used with any dispatcher. Like @ref
+ *  ConcreteSemantics, there is no representation for undefined values, which are all zero, and states cannot be merged. */
+namespace FastConcreteSemantics {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Value type
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Smart-ownership pointer to a fast concrete semantic value. See @ref heap_object_shared_ownership. */
+typedef Sawyer::SharedPointer<class SValue> SValuePtr;
+
+/** Formatter for fast concrete values. */
+typedef BaseSemantics::Formatter Formatter;
+
+/** Type of values manipulated by the fast concrete domain.
+ *
+ *  Each value has a known size and known bits.  Values up to 64 bits wide are stored in a 64-bit integer whose bits above the
+ *  width are always clear; wider values are stored in a bit vector. */
+class SValue: public BaseSemantics::SValue {
+protected:
+    uint64_t value_;                                    // bits for values up to 64 bits wide
+    Sawyer::Container::BitVector *wide_;                // bits for values wider than 64 bits, otherwise null
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Real constructors
+protected:
+    explicit SValue(size_t nbits)
+        : BaseSemantics::SValue(nbits), value_(0), wide_(nbits > 64 ? new Sawyer::Container::BitVector(nbits) : NULL) {}
+
+    SValue(size_t nbits, uint64_t number)
+        : BaseSemantics::SValue(nbits), value_(0), wide_(NULL) {
+        if (nbits > 64) {
+            wide_ = new Sawyer::Container::BitVector(nbits);
+            wide_->fromInteger(Sawyer::Container::BitVector::BitRange::baseSize(0, 64), number);
+        } else {
+            value_ = number & mask(nbits);
+        }
+    }
+
+    explicit SValue(const Sawyer::Container::BitVector &bits)
+        : BaseSemantics::SValue(bits.size()), value_(0), wide_(NULL) {
+        if (bits.size() > 64) {
+            wide_ = new Sawyer::Container::BitVector(bits);
+        } else {
+            value_ = bits.toInteger();
+        }
+    }
+
+    SValue(const SValue &other)
+        : BaseSemantics::SValue(other), value_(other.value_),
+          wide_(other.wide_ ? new Sawyer::Container::BitVector(*other.wide_) : NULL) {}
+
+private:
+    SValue& operator=(const SValue&);                   // not implemented
+
+public:
+    virtual ~SValue() {
+        delete wide_;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Static allocating constructors
+public:
+    /** Instantiate a new prototypical value. Prototypical values are only used for their virtual constructors. */
+    static SValuePtr instance() {
+        return SValuePtr(new SValue(1));
+    }
+
+    /** Instantiate a new value of specified width with all bits clear. */
+    static SValuePtr instance(size_t nbits) {
+        return SValuePtr(new SValue(nbits));
+    }
+
+    /** Instantiate a new concrete value. Only the low-order 64 bits of wider values can be specified. */
+    static SValuePtr instance(size_t nbits, uint64_t value) {
+        return SValuePtr(new SValue(nbits, value));
+    }
+
+    /** Instantiate a new concrete value from a bit vector. */
+    static SValuePtr instance(const Sawyer::Container::BitVector &bits) {
+        return SValuePtr(new SValue(bits));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Virtual allocating constructors
+public:
+    virtual BaseSemantics::SValuePtr undefined_(size_t nbits) const ROSE_OVERRIDE {
+        return instance(nbits);
+    }
+    virtual BaseSemantics::SValuePtr unspecified_(size_t nbits) const ROSE_OVERRIDE {
+        return instance(nbits);
+    }
+    virtual BaseSemantics::SValuePtr bottom_(size_t nbits) const ROSE_OVERRIDE {
+        return instance(nbits);
+    }
+    virtual BaseSemantics::SValuePtr number_(size_t nbits, uint64_t value) const ROSE_OVERRIDE {
+        return instance(nbits, value);
+    }
+    virtual BaseSemantics::SValuePtr boolean_(bool value) const ROSE_OVERRIDE {
+        return instance(1, value ? 1 : 0);
+    }
+    virtual BaseSemantics::SValuePtr copy(size_t new_width=0) const ROSE_OVERRIDE {
+        SValuePtr retval(new SValue(*this));
+        if (new_width!=0 && new_width!=retval->get_width())
+            retval->set_width(new_width);
+        return retval;
+    }
+    virtual Sawyer::Optional<BaseSemantics::SValuePtr>
+    createOptionalMerge(const BaseSemantics::SValuePtr &other, const BaseSemantics::MergerPtr&, SMTSolver*) const ROSE_OVERRIDE;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Dynamic pointer casts
+public:
+    /** Promote a base value to a fast concrete value.  The value @p v must have a FastConcreteSemantics::SValue dynamic type. */
+    static SValuePtr promote(const BaseSemantics::SValuePtr &v) {
+        SValuePtr retval = v.dynamicCast<SValue>();
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    /** Promote without changing the reference count.  This is what the RISC operators use internally. */
+    static const SValue* raw(const BaseSemantics::SValuePtr &v) {
+        const SValue *retval = dynamic_cast<const SValue*>(getRawPointer(v));
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Override virtual methods...
+public:
+    virtual bool may_equal(const BaseSemantics::SValuePtr &other, SMTSolver *solver=NULL) const ROSE_OVERRIDE;
+    virtual bool must_equal(const BaseSemantics::SValuePtr &other, SMTSolver *solver=NULL) const ROSE_OVERRIDE;
+
+    virtual void set_width(size_t nbits) ROSE_OVERRIDE;
+
+    virtual bool isBottom() const ROSE_OVERRIDE {
+        return false;
+    }
+
+    virtual bool is_number() const ROSE_OVERRIDE {
+        return true;
+    }
+
+    /** Returns the value, or the low-order 64 bits of a wider value. */
+    virtual uint64_t get_number() const ROSE_OVERRIDE;
+
+    virtual void print(std::ostream&, BaseSemantics::Formatter&) const ROSE_OVERRIDE;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Additional methods first declared in this class...
+public:
+    /** Whether the value is wider than 64 bits. */
+    bool isWide() const { return wide_ != NULL; }
+
+    /** Value of a value that is 64 bits or narrower. */
+    uint64_t value() const {
+        ASSERT_require(wide_ == NULL);
+        return value_;
+    }
+
+    /** Bits of the value as a bit vector. */
+    Sawyer::Container::BitVector bits() const;
+
+    /** Mask with the low-order @p nbits set. */
+    static uint64_t mask(size_t nbits) {
+        return nbits >= 64 ? ~(uint64_t)0 : ((uint64_t)1 << nbits) - 1;
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Register State
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Shared-ownership pointer to a fast concrete register state. See @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<class RegisterState> RegisterStatePtr;
+
+/** Flat register file.
+ *
+ *  Each distinct major and minor number in the register dictionary (e.g., "rax" and all its parts) is a location in an array
+ *  of 64-bit words, sized for the widest register having those numbers.  Locations for registers that are not in the
+ *  dictionary are added when they're first accessed.
+ *
+ *  All locations start out zero.  A location that has never been read or written is initialized from the default value
+ *  passed to @ref readRegister the first time any part of it is read, which is how a lazily-initialized initial state
+ *  works with the other register states. */
+class RegisterState: public BaseSemantics::RegisterState {
+    struct Location {
+        size_t offset;                                  // index of the location's first word
+        size_t nBits;                                   // capacity in bits
+        bool stored;                                    // whether the location has been written or initialized
+        Location(): offset(0), nBits(0), stored(false) {}
+        Location(size_t offset, size_t nBits): offset(offset), nBits(nBits), stored(false) {}
+    };
+
+    std::vector<uint64_t> words_;                       // storage for all locations
+    std::vector<Location> locations_;
+    std::vector<std::vector<int> > index_;              // location index by major and minor number, or -1
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Real constructors
+protected:
+    RegisterState(const BaseSemantics::SValuePtr &protoval, const RegisterDictionary *regdict);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Static allocating constructors
+public:
+    /** Instantiate a new register state with all registers zero. */
+    static RegisterStatePtr instance(const BaseSemantics::SValuePtr &protoval, const RegisterDictionary *regdict) {
+        return RegisterStatePtr(new RegisterState(protoval, regdict));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Virtual constructors
+public:
+    virtual BaseSemantics::RegisterStatePtr create(const BaseSemantics::SValuePtr &protoval,
+                                                   const RegisterDictionary *regdict) const ROSE_OVERRIDE {
+        return instance(protoval, regdict);
+    }
+
+    virtual BaseSemantics::RegisterStatePtr clone() const ROSE_OVERRIDE {
+        return RegisterStatePtr(new RegisterState(*this));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Dynamic pointer casts
+public:
+    /** Run-time promotion of a base register state pointer to a fast concrete register state. */
+    static RegisterStatePtr promote(const BaseSemantics::RegisterStatePtr &x) {
+        RegisterStatePtr retval = boost::dynamic_pointer_cast<RegisterState>(x);
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Methods we inherited
+public:
+    /** Set all registers to zero and mark them as never accessed. */
+    virtual void clear() ROSE_OVERRIDE;
+
+    /** Set all registers to zero. */
+    virtual void zero() ROSE_OVERRIDE;
+
+    virtual bool merge(const BaseSemantics::RegisterStatePtr &other, BaseSemantics::RiscOperators *ops) ROSE_OVERRIDE;
+
+    virtual BaseSemantics::SValuePtr readRegister(const RegisterDescriptor&, const BaseSemantics::SValuePtr &dflt,
+                                                  BaseSemantics::RiscOperators *ops) ROSE_OVERRIDE;
+
+    virtual void writeRegister(const RegisterDescriptor&, const BaseSemantics::SValuePtr &value,
+                               BaseSemantics::RiscOperators *ops) ROSE_OVERRIDE;
+
+    virtual void print(std::ostream&, Formatter&) const ROSE_OVERRIDE;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Methods first declared in this class
+public:
+    /** Read a register.  Registers that have never been accessed are zero. */
+    SValuePtr readRegister(const RegisterDescriptor&);
+
+    /** Write a register. */
+    void writeRegister(const RegisterDescriptor&, const SValue*);
+
+protected:
+    // Location for a register, creating or widening it if necessary.
+    Location& location(const RegisterDescriptor&);
+
+    // Read or write bits of a location. The words are little-endian: bit 0 of the location is bit 0 of its first word.
+    uint64_t readBits(const Location&, size_t offset, size_t nBits) const;
+    void writeBits(const Location&, size_t offset, size_t nBits, uint64_t value);
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Memory State
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Shared-ownership pointer to a fast concrete memory state. See @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<class MemoryState> MemoryStatePtr;
+
+/** Byte-addressable paged memory.
+ *
+ *  Memory is a table of 4096-byte pages indexed by page number.  A page is created the first time it's accessed by copying
+ *  its initial contents from the memory map (see @ref memoryMap), or zero for addresses that the map doesn't contain.  Writes
+ *  change only the pages, never the memory map, and access permissions in the map are not checked.
+ *
+ *  A direct-mapped cache of recently used pages (like a processor's TLB) is consulted before the page table. */
+class MemoryState: public BaseSemantics::MemoryState {
+public:
+    enum { PAGE_SIZE_BITS = 12 };
+    enum { PAGE_SIZE = 1 << PAGE_SIZE_BITS };           /**< Bytes per page. */
+    enum { TLB_SIZE = 64 };                             /**< Number of entries in the page cache. */
+
+private:
+    typedef Sawyer::Container::Map<rose_addr_t, uint8_t*> Pages;
+
+    struct TlbEntry {
+        rose_addr_t pageNumber;
+        uint8_t *page;
+        TlbEntry(): pageNumber(~(rose_addr_t)0), page(NULL) {}
+    };
+
+    MemoryMap map_;                                     // initial contents
+    Pages pages_;                                       // owned pages indexed by page number
+    TlbEntry tlb_[TLB_SIZE];
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Real constructors
+protected:
+    MemoryState(const BaseSemantics::SValuePtr &addrProtoval, const BaseSemantics::SValuePtr &valProtoval)
+        : BaseSemantics::MemoryState(addrProtoval, valProtoval) {
+        (void) SValue::promote(addrProtoval);           // for its checking side effects
+        (void) SValue::promote(valProtoval);
+    }
+
+    MemoryState(const MemoryState &other);
+
+private:
+    MemoryState& operator=(const MemoryState&);         // not implemented
+
+public:
+    virtual ~MemoryState();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Static allocating constructors
+public:
+    /** Instantiates a new, empty memory state having specified prototypical values. */
+    static MemoryStatePtr instance(const BaseSemantics::SValuePtr &addrProtoval, const BaseSemantics::SValuePtr &valProtoval) {
+        return MemoryStatePtr(new MemoryState(addrProtoval, valProtoval));
+    }
+
+    /** Instantiates a new deep copy of an existing state. */
+    static MemoryStatePtr instance(const MemoryStatePtr &other) {
+        return MemoryStatePtr(new MemoryState(*other));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Virtual constructors
+public:
+    virtual BaseSemantics::MemoryStatePtr create(const BaseSemantics::SValuePtr &addrProtoval,
+                                                 const BaseSemantics::SValuePtr &valProtoval) const ROSE_OVERRIDE {
+        return instance(addrProtoval, valProtoval);
+    }
+
+    /** Virtual copy constructor.  The pages are copied; the memory map's buffers are shared since they're never written. */
+    virtual BaseSemantics::MemoryStatePtr clone() const ROSE_OVERRIDE {
+        return MemoryStatePtr(new MemoryState(*this));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Dynamic pointer casts
+public:
+    /** Recasts a base pointer to a fast concrete memory state. This is a checked cast. */
+    static MemoryStatePtr promote(const BaseSemantics::MemoryStatePtr &x) {
+        MemoryStatePtr retval = boost::dynamic_pointer_cast<MemoryState>(x);
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Methods we inherited
+public:
+    /** Discard all pages and the memory map. */
+    virtual void clear() ROSE_OVERRIDE;
+
+    virtual void print(std::ostream&, Formatter&) const ROSE_OVERRIDE;
+
+    virtual BaseSemantics::SValuePtr readMemory(const BaseSemantics::SValuePtr &addr, const BaseSemantics::SValuePtr &dflt,
+                                                BaseSemantics::RiscOperators *addrOps,
+                                                BaseSemantics::RiscOperators *valOps) ROSE_OVERRIDE;
+
+    virtual void writeMemory(const BaseSemantics::SValuePtr &addr, const BaseSemantics::SValuePtr &value,
+                             BaseSemantics::RiscOperators *addrOps, BaseSemantics::RiscOperators *valOps) ROSE_OVERRIDE;
+
+    virtual bool merge(const BaseSemantics::MemoryStatePtr &other, BaseSemantics::RiscOperators *addrOps,
+                       BaseSemantics::RiscOperators *valOps) ROSE_OVERRIDE;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Methods first declared in this class
+public:
+    /** Property: initial memory contents.
+     *
+     *  Setting the memory map discards all pages, so memory reverts to the contents of the new map.
+     *
+     * @{ */
+    const MemoryMap& memoryMap() const { return map_; }
+    void memoryMap(const MemoryMap&);
+    /** @} */
+
+    /** Read bytes.  Reads @p nBytes bytes starting at @p va into @p buffer. Addresses wrap around at the end of the address
+     *  space. */
+    void readBytes(rose_addr_t va, uint8_t *buffer, size_t nBytes);
+
+    /** Write bytes.  Writes @p nBytes bytes from @p buffer starting at @p va. */
+    void writeBytes(rose_addr_t va, const uint8_t *buffer, size_t nBytes);
+
+    /** Number of pages that have been accessed. */
+    size_t nPages() const { return pages_.size(); }
+
+protected:
+    // Page containing the specified address, created if necessary.
+    uint8_t* page(rose_addr_t va) {
+        rose_addr_t pageNumber = va >> PAGE_SIZE_BITS;
+        TlbEntry &entry = tlb_[pageNumber % TLB_SIZE];
+        if (entry.pageNumber != pageNumber) {
+            entry.page = lookupPage(pageNumber);
+            entry.pageNumber = pageNumber;
+        }
+        return entry.page;
+    }
+
+    // Page table lookup, creating the page if necessary.
+    uint8_t* lookupPage(rose_addr_t pageNumber);
+
+    // Invalidate all page cache entries.
+    void flushTlb();
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Complete semantic state
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+typedef BaseSemantics::State State;
+typedef BaseSemantics::StatePtr StatePtr;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      RISC operators
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Shared-ownership pointer to fast concrete RISC operations. See @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<class RiscOperators> RiscOperatorsPtr;
+
+/** Defines RISC operators for the FastConcreteSemantics domain.
+ *
+ *  Operations whose operands and result are all 64 bits or narrower are computed directly.  Other operations, and the
+ *  floating-point operations, are delegated to a @ref ConcreteSemantics::RiscOperators object.  When the current state has
+ *  this domain's register and memory states and there's no lazily-updated initial state, register and memory accesses go
+ *  straight to the states; otherwise they go through the generic State interface. */
+class RiscOperators: public BaseSemantics::RiscOperators {
+    ConcreteSemantics::RiscOperatorsPtr wideOps_;       // operators for wide values and floating-point
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Real constructors
+protected:
+    RiscOperators(const BaseSemantics::SValuePtr &protoval, SMTSolver *solver)
+        : BaseSemantics::RiscOperators(protoval, solver) {
+        name("FastConcrete");
+        (void) SValue::promote(protoval);
+        init();
+    }
+
+    RiscOperators(const BaseSemantics::StatePtr &state, SMTSolver *solver)
+        : BaseSemantics::RiscOperators(state, solver) {
+        name("FastConcrete");
+        (void) SValue::promote(state->protoval());
+        init();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Static allocating constructors
+public:
+    /** Instantiates a new RiscOperators object with a fast concrete register state and memory state. */
+    static RiscOperatorsPtr instance(const RegisterDictionary *regdict, SMTSolver *solver=NULL) {
+        BaseSemantics::SValuePtr protoval = SValue::instance();
+        BaseSemantics::RegisterStatePtr registers = RegisterState::instance(protoval, regdict);
+        BaseSemantics::MemoryStatePtr memory = MemoryState::instance(protoval, protoval);
+        BaseSemantics::StatePtr state = State::instance(registers, memory);
+        return RiscOperatorsPtr(new RiscOperators(state, solver));
+    }
+
+    /** Instantiates a new RiscOperators object with specified prototypical values. */
+    static RiscOperatorsPtr instance(const BaseSemantics::SValuePtr &protoval, SMTSolver *solver=NULL) {
+        return RiscOperatorsPtr(new RiscOperators(protoval, solver));
+    }
+
+    /** Instantiates a new RiscOperators object with specified state. */
+    static RiscOperatorsPtr instance(const BaseSemantics::StatePtr &state, SMTSolver *solver=NULL) {
+        return RiscOperatorsPtr(new RiscOperators(state, solver));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Virtual constructors
+public:
+    virtual BaseSemantics::RiscOperatorsPtr create(const BaseSemantics::SValuePtr &protoval,
+                                                   SMTSolver *solver=NULL) const ROSE_OVERRIDE {
+        return instance(protoval, solver);
+    }
+
+    virtual BaseSemantics::RiscOperatorsPtr create(const BaseSemantics::StatePtr &state,
+                                                   SMTSolver *solver=NULL) const ROSE_OVERRIDE {
+        return instance(state, solver);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Dynamic pointer casts
+public:
+    /** Run-time promotion of a base RiscOperators pointer to fast concrete operators. This is a checked conversion. */
+    static RiscOperatorsPtr promote(const BaseSemantics::RiscOperatorsPtr &x) {
+        RiscOperatorsPtr retval = boost::dynamic_pointer_cast<RiscOperators>(x);
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Override methods from base class.  These are the RISC operators that are invoked by a Dispatcher.
+public:
+    virtual BaseSemantics::SValuePtr undefined_(size_t nbits) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr unspecified_(size_t nbits) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr number_(size_t nbits, uint64_t value) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr boolean_(bool value) ROSE_OVERRIDE;
+
+    virtual void interrupt(int majr, int minr) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr and_(const BaseSemantics::SValuePtr &a_,
+                                          const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr or_(const BaseSemantics::SValuePtr &a_,
+                                         const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr xor_(const BaseSemantics::SValuePtr &a_,
+                                          const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr invert(const BaseSemantics::SValuePtr &a_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr extract(const BaseSemantics::SValuePtr &a_,
+                                             size_t begin_bit, size_t end_bit) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr concat(const BaseSemantics::SValuePtr &a_,
+                                            const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr leastSignificantSetBit(const BaseSemantics::SValuePtr &a_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr mostSignificantSetBit(const BaseSemantics::SValuePtr &a_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr rotateLeft(const BaseSemantics::SValuePtr &a_,
+                                                const BaseSemantics::SValuePtr &sa_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr rotateRight(const BaseSemantics::SValuePtr &a_,
+                                                 const BaseSemantics::SValuePtr &sa_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr shiftLeft(const BaseSemantics::SValuePtr &a_,
+                                               const BaseSemantics::SValuePtr &sa_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr shiftRight(const BaseSemantics::SValuePtr &a_,
+                                                const BaseSemantics::SValuePtr &sa_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr shiftRightArithmetic(const BaseSemantics::SValuePtr &a_,
+                                                          const BaseSemantics::SValuePtr &sa_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr equalToZero(const BaseSemantics::SValuePtr &a_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr ite(const BaseSemantics::SValuePtr &sel_,
+                                         const BaseSemantics::SValuePtr &a_,
+                                         const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isEqual(const BaseSemantics::SValuePtr &a_,
+                                             const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isNotEqual(const BaseSemantics::SValuePtr &a_,
+                                                const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isUnsignedLessThan(const BaseSemantics::SValuePtr &a_,
+                                                        const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isUnsignedLessThanOrEqual(const BaseSemantics::SValuePtr &a_,
+                                                               const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isUnsignedGreaterThan(const BaseSemantics::SValuePtr &a_,
+                                                           const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isUnsignedGreaterThanOrEqual(const BaseSemantics::SValuePtr &a_,
+                                                                  const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isSignedLessThan(const BaseSemantics::SValuePtr &a_,
+                                                      const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isSignedLessThanOrEqual(const BaseSemantics::SValuePtr &a_,
+                                                             const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isSignedGreaterThan(const BaseSemantics::SValuePtr &a_,
+                                                         const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isSignedGreaterThanOrEqual(const BaseSemantics::SValuePtr &a_,
+                                                                const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr unsignedExtend(const BaseSemantics::SValuePtr &a_, size_t new_width) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr signExtend(const BaseSemantics::SValuePtr &a_, size_t new_width) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr add(const BaseSemantics::SValuePtr &a_,
+                                         const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr subtract(const BaseSemantics::SValuePtr &a_,
+                                              const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr addWithCarries(const BaseSemantics::SValuePtr &a_,
+                                                    const BaseSemantics::SValuePtr &b_,
+                                                    const BaseSemantics::SValuePtr &c_,
+                                                    BaseSemantics::SValuePtr &carry_out/*out*/) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr negate(const BaseSemantics::SValuePtr &a_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr signedDivide(const BaseSemantics::SValuePtr &a_,
+                                                  const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr signedModulo(const BaseSemantics::SValuePtr &a_,
+                                                  const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr signedMultiply(const BaseSemantics::SValuePtr &a_,
+                                                    const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr unsignedDivide(const BaseSemantics::SValuePtr &a_,
+                                                    const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr unsignedModulo(const BaseSemantics::SValuePtr &a_,
+                                                    const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr unsignedMultiply(const BaseSemantics::SValuePtr &a_,
+                                                      const BaseSemantics::SValuePtr &b_) ROSE_OVERRIDE;
+
+    virtual BaseSemantics::SValuePtr fpFromInteger(const BaseSemantics::SValuePtr &intValue, SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpToInteger(const BaseSemantics::SValuePtr &fpValue, SgAsmFloatType *fpType,
+                                                 const BaseSemantics::SValuePtr &dflt) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpAdd(const BaseSemantics::SValuePtr &a, const BaseSemantics::SValuePtr &b,
+                                           SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpSubtract(const BaseSemantics::SValuePtr &a, const BaseSemantics::SValuePtr &b,
+                                                SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpMultiply(const BaseSemantics::SValuePtr &a, const BaseSemantics::SValuePtr &b,
+                                                SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpRoundTowardZero(const BaseSemantics::SValuePtr &a, SgAsmFloatType*) ROSE_OVERRIDE;
+
+    virtual BaseSemantics::SValuePtr readRegister(const RegisterDescriptor &reg) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr readRegister(const RegisterDescriptor &reg,
+                                                  const BaseSemantics::SValuePtr &dflt) ROSE_OVERRIDE;
+    virtual void writeRegister(const RegisterDescriptor &reg, const BaseSemantics::SValuePtr &a) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr readMemory(const RegisterDescriptor &segreg,
+                                                const BaseSemantics::SValuePtr &addr,
+                                                const BaseSemantics::SValuePtr &dflt,
+                                                const BaseSemantics::SValuePtr &cond) ROSE_OVERRIDE;
+    virtual void writeMemory(const RegisterDescriptor &segreg,
+                             const BaseSemantics::SValuePtr &addr,
+                             const BaseSemantics::SValuePtr &data,
+                             const BaseSemantics::SValuePtr &cond) ROSE_OVERRIDE;
+
+protected:
+    void init();
+
+    // Register and memory states of the current state if they're this domain's and can be accessed directly, otherwise null.
+    RegisterState* fastRegisters() const;
+    MemoryState* fastMemory() const;
+
+    // Conversion to and from ConcreteSemantics values for the delegated operations.
+    BaseSemantics::SValuePtr toConcrete(const BaseSemantics::SValuePtr&);
+    BaseSemantics::SValuePtr fromConcrete(const BaseSemantics::SValuePtr&);
+};
+
+} // namespace
+} // namespace
+} // namespace
+} // namespace
+
+#endif
@@ -0,0 +1,385 @@
+#ifndef Rose_MicroOpSemantics2_H
+#define Rose_MicroOpSemantics2_H
+
+#include "BaseSemantics2.h"
+
+namespace rose {
+namespace BinaryAnalysis {                      // documented elsewhere
+namespace InstructionSemantics2 {               // documented elsewhere
+
+/** Pre-translated instruction semantics.
+ *
+ *  Processing an instruction with a dispatcher decodes its operands, walks its expression trees, and runs through several
+ *  layers of virtual instruction processors before the first RISC operator is invoked.  When the same instruction is
+ *  processed many times (emulation loops, path exploration) that work can be done once: the instruction is processed a single
+ *  time with this domain's RiscOperators, which record every RISC operator call as a @ref MicroOp in a @ref Trace instead of
+ *  computing anything.  The trace is a linear list of operator calls whose operands are numbered value slots, constants and
+ *  resolved register descriptors, and it can be replayed against the RiscOperators of any other domain with @ref
+ *  Trace::replay.  Replaying invokes exactly the RISC operators, with exactly the arguments, that the dispatcher would have
+ *  invoked.
+ *
+ *  Not every instruction can be translated.  The dispatcher sometimes inspects values, such as when it checks whether a
+ *  divisor is the constant zero or whether a repeat count is known.  Recorded values are known only if they were created by
+ *  @ref RiscOperators::number_ "number_" or @ref RiscOperators::boolean_ "boolean_"; asking anything else about any other
+ *  value throws @ref NotTranslatable, and such instructions must be processed by the dispatcher each time.
+ *
+ *  See DispatcherX86::translationCache for the cache that uses this domain. */
+namespace MicroOpSemantics {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Traces
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Kinds of micro-operations. Most correspond one to one to a RiscOperators method of the same name. */
+enum Opcode {
+    OP_UNDEFINED, OP_UNSPECIFIED, OP_NUMBER, OP_BOOLEAN, OP_BOTTOM,
+    OP_FILTER_CALL_TARGET, OP_FILTER_RETURN_TARGET, OP_FILTER_INDIRECT_JUMP_TARGET,
+    OP_HLT, OP_CPUID, OP_RDTSC,
+    OP_AND, OP_OR, OP_XOR, OP_INVERT, OP_EXTRACT, OP_CONCAT,
+    OP_LEAST_SIGNIFICANT_SET_BIT, OP_MOST_SIGNIFICANT_SET_BIT,
+    OP_ROTATE_LEFT, OP_ROTATE_RIGHT, OP_SHIFT_LEFT, OP_SHIFT_RIGHT, OP_SHIFT_RIGHT_ARITHMETIC,
+    OP_EQUAL_TO_ZERO, OP_ITE,
+    OP_IS_EQUAL, OP_IS_NOT_EQUAL,
+    OP_IS_UNSIGNED_LESS_THAN, OP_IS_UNSIGNED_LESS_THAN_OR_EQUAL,
+    OP_IS_UNSIGNED_GREATER_THAN, OP_IS_UNSIGNED_GREATER_THAN_OR_EQUAL,
+    OP_IS_SIGNED_LESS_THAN, OP_IS_SIGNED_LESS_THAN_OR_EQUAL,
+    OP_IS_SIGNED_GREATER_THAN, OP_IS_SIGNED_GREATER_THAN_OR_EQUAL,
+    OP_UNSIGNED_EXTEND, OP_SIGN_EXTEND,
+    OP_ADD, OP_SUBTRACT, OP_ADD_WITH_CARRIES, OP_NEGATE,
+    OP_SIGNED_DIVIDE, OP_SIGNED_MODULO, OP_SIGNED_MULTIPLY,
+    OP_UNSIGNED_DIVIDE, OP_UNSIGNED_MODULO, OP_UNSIGNED_MULTIPLY,
+    OP_INTERRUPT,
+    OP_FP_FROM_INTEGER, OP_FP_TO_INTEGER, OP_FP_CONVERT,
+    OP_FP_IS_NAN, OP_FP_IS_DENORMALIZED, OP_FP_IS_ZERO, OP_FP_IS_INFINITY, OP_FP_SIGN, OP_FP_EFFECTIVE_EXPONENT,
+    OP_FP_ADD, OP_FP_SUBTRACT, OP_FP_MULTIPLY, OP_FP_DIVIDE, OP_FP_SQUARE_ROOT, OP_FP_ROUND_TOWARD_ZERO,
+    OP_READ_REGISTER,                                   /**< readRegister without a default value. */
+    OP_READ_REGISTER_DFLT,                              /**< readRegister with a default value. */
+    OP_WRITE_REGISTER, OP_READ_MEMORY, OP_WRITE_MEMORY,
+    OP_ADVANCE_INSTRUCTION_POINTER                      /**< Dispatcher::advanceInstructionPointer, which depends on the state. */
+};
+
+/** One recorded RISC operator call.
+ *
+ *  The operands are indices into the value slots of the trace.  Which of the fields are used depends on the opcode, e.g.,
+ *  @c OP_EXTRACT uses @c args[0], @c n1 (begin bit) and @c n2 (end bit); @c OP_ADD_WITH_CARRIES stores the carry-out slot in
+ *  @c n1; @c OP_INTERRUPT stores the major and minor numbers in @c n1 and @c n2. */
+struct MicroOp {
+    Opcode opcode;
+    unsigned result;                                    /**< Slot that receives the return value, if any. */
+    unsigned args[4];                                   /**< Slots of the value arguments. */
+    uint64_t n1, n2;                                    /**< Widths, bit positions, constants, interrupt numbers. */
+    RegisterDescriptor reg;                             /**< Register, or segment register for memory operations. */
+    SgAsmFloatType *type1, *type2;                      /**< Floating-point types. */
+
+    explicit MicroOp(Opcode opcode)
+        : opcode(opcode), result(0), n1(0), n2(0), type1(NULL), type2(NULL) {
+        args[0] = args[1] = args[2] = args[3] = 0;
+    }
+};
+
+/** Shared-ownership pointer to a trace. */
+typedef boost::shared_ptr<const class Trace> TracePtr;
+
+/** RISC operator calls for one instruction.
+ *
+ *  A trace is valid for the instruction bytes from which it was translated, at the address where they were translated.  It
+ *  does not refer to the instruction's AST, and can therefore be replayed for any instruction that has the same address and
+ *  bytes. */
+class Trace {
+public:
+    rose_addr_t address;                                /**< Address of the translated instruction. */
+    SgUnsignedCharList bytes;                           /**< Bytes of the translated instruction. */
+    std::vector<MicroOp> ops;                           /**< Micro-operations in the order they are performed. */
+    size_t nSlots;                                      /**< Number of value slots used by the micro-operations. */
+
+    Trace(): address(0), nSlots(0) {}
+
+    /** Whether this trace was translated from the specified instruction's address and bytes. */
+    bool matches(SgAsmInstruction *insn) const {
+        return insn->get_address() == address && insn->get_raw_bytes() == bytes;
+    }
+
+    /** Perform the micro-operations.
+     *
+     *  The RISC operators are invoked for the instruction @p insn, which must match this trace.  The caller is responsible for
+     *  calling startInstruction and finishInstruction.  The @p dispatcher is needed only for @c
+     *  OP_ADVANCE_INSTRUCTION_POINTER.  The @p slots vector is scratch space that can be reused across calls to avoid
+     *  reallocating it for each instruction; it is left cleared. */
+    void replay(BaseSemantics::RiscOperators *ops, BaseSemantics::Dispatcher *dispatcher, SgAsmInstruction *insn,
+                std::vector<BaseSemantics::SValuePtr> &slots) const;
+
+    /** Print the micro-operations, one per line. */
+    void print(std::ostream&) const;
+};
+
+/** Exception thrown when an instruction cannot be translated.
+ *
+ *  This is thrown by the recording operators when the dispatcher asks about a value that is not known at translation time, or
+ *  by the dispatcher when an instruction's semantics depend on the state in a way that cannot be recorded. */
+class NotTranslatable: public BaseSemantics::Exception {
+public:
+    NotTranslatable(const std::string &mesg, SgAsmInstruction *insn)
+        : BaseSemantics::Exception(mesg, insn) {}
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      Semantic values
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Shared-ownership pointer to a recorded value. See @ref heap_object_shared_ownership. */
+typedef Sawyer::SharedPointer<class SValue> SValuePtr;
+
+/** Recorded value.
+ *
+ *  A value is the number of the trace slot where its replayed counterpart will be stored.  Constants also remember their
+ *  value, which is the only thing that the dispatcher is allowed to inspect during translation. */
+class SValue: public BaseSemantics::SValue {
+    unsigned slot_;
+    bool isNumber_;
+    uint64_t value_;
+
+protected:
+    SValue(size_t nbits, unsigned slot)
+        : BaseSemantics::SValue(nbits), slot_(slot), isNumber_(false), value_(0) {}
+
+    SValue(size_t nbits, unsigned slot, uint64_t number)
+        : BaseSemantics::SValue(nbits), slot_(slot), isNumber_(true), value_(number) {
+        if (nbits < 64)
+            value_ &= ((uint64_t)1 << nbits) - 1;
+    }
+
+public:
+    /** Instantiate a new prototypical value. Prototypical values are only used for their virtual constructors. */
+    static SValuePtr instance() {
+        return SValuePtr(new SValue(1, 0));
+    }
+
+    /** Instantiate a value that is stored in the specified slot. */
+    static SValuePtr instance(size_t nbits, unsigned slot) {
+        return SValuePtr(new SValue(nbits, slot));
+    }
+
+    /** Instantiate a constant that is stored in the specified slot. */
+    static SValuePtr instance(size_t nbits, unsigned slot, uint64_t number) {
+        return SValuePtr(new SValue(nbits, slot, number));
+    }
+
+    // Values are created only by the recording RiscOperators, which assign slots. The virtual constructors cannot do that.
+    virtual BaseSemantics::SValuePtr bottom_(size_t nbits) const ROSE_OVERRIDE { notRecorded(); return SValuePtr(); }
+    virtual BaseSemantics::SValuePtr undefined_(size_t nbits) const ROSE_OVERRIDE { notRecorded(); return SValuePtr(); }
+    virtual BaseSemantics::SValuePtr unspecified_(size_t nbits) const ROSE_OVERRIDE { notRecorded(); return SValuePtr(); }
+    virtual BaseSemantics::SValuePtr number_(size_t nbits, uint64_t number) const ROSE_OVERRIDE {
+        notRecorded();
+        return SValuePtr();
+    }
+    virtual BaseSemantics::SValuePtr copy(size_t new_width=0) const ROSE_OVERRIDE { notRecorded(); return SValuePtr(); }
+    virtual Sawyer::Optional<BaseSemantics::SValuePtr>
+    createOptionalMerge(const BaseSemantics::SValuePtr&, const BaseSemantics::MergerPtr&, SMTSolver*) const ROSE_OVERRIDE {
+        notRecorded();
+        return Sawyer::Nothing();
+    }
+
+    /** Promote a base value to a recorded value. */
+    static SValuePtr promote(const BaseSemantics::SValuePtr &v) {
+        SValuePtr retval = v.dynamicCast<SValue>();
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    /** Slot in which the replayed value is stored. */
+    unsigned slot() const { return slot_; }
+
+    virtual bool isBottom() const ROSE_OVERRIDE {
+        return false;
+    }
+    virtual bool is_number() const ROSE_OVERRIDE {
+        if (!isNumber_)
+            throw NotTranslatable("instruction semantics depend on a computed value", NULL);
+        return true;
+    }
+    virtual uint64_t get_number() const ROSE_OVERRIDE {
+        if (!isNumber_)
+            throw NotTranslatable("instruction semantics depend on a computed value", NULL);
+        return value_;
+    }
+    virtual bool may_equal(const BaseSemantics::SValuePtr &other, SMTSolver *solver=NULL) const ROSE_OVERRIDE;
+    virtual bool must_equal(const BaseSemantics::SValuePtr &other, SMTSolver *solver=NULL) const ROSE_OVERRIDE;
+    virtual void print(std::ostream&, BaseSemantics::Formatter&) const ROSE_OVERRIDE;
+
+private:
+    void notRecorded() const {
+        throw NotTranslatable("value created outside the RISC operators", NULL);
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//                                      RISC operators
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/** Shared-ownership pointer to recording RISC operations. See @ref heap_object_shared_ownership. */
+typedef boost::shared_ptr<class RiscOperators> RiscOperatorsPtr;
+
+/** RISC operators that record their calls.
+ *
+ *  Each operator appends one micro-operation to the trace and returns a new value for its result slot.  There is no state;
+ *  the operators work only together with a dispatcher whose instruction semantics don't access the state directly. */
+class RiscOperators: public BaseSemantics::RiscOperators {
+    Trace *trace_;
+
+protected:
+    explicit RiscOperators(const BaseSemantics::SValuePtr &protoval, SMTSolver *solver=NULL)
+        : BaseSemantics::RiscOperators(protoval, solver), trace_(NULL) {
+        name("MicroOp");
+    }
+
+public:
+    /** Instantiates recording operators. */
+    static RiscOperatorsPtr instance() {
+        return RiscOperatorsPtr(new RiscOperators(SValue::instance()));
+    }
+
+    virtual BaseSemantics::RiscOperatorsPtr create(const BaseSemantics::SValuePtr &protoval,
+                                                   SMTSolver *solver=NULL) const ROSE_OVERRIDE {
+        return RiscOperatorsPtr(new RiscOperators(protoval, solver));
+    }
+    virtual BaseSemantics::RiscOperatorsPtr create(const BaseSemantics::StatePtr&, SMTSolver *solver=NULL) const ROSE_OVERRIDE {
+        return RiscOperatorsPtr(new RiscOperators(SValue::instance(), solver));
+    }
+
+    /** Run-time promotion of a base RiscOperators pointer to recording operators. */
+    static RiscOperatorsPtr promote(const BaseSemantics::RiscOperatorsPtr &x) {
+        RiscOperatorsPtr retval = boost::dynamic_pointer_cast<RiscOperators>(x);
+        ASSERT_not_null(retval);
+        return retval;
+    }
+
+    /** Property: trace to which micro-operations are appended.
+     *
+     * @{ */
+    Trace* trace() const { return trace_; }
+    void trace(Trace *t) { trace_ = t; }
+    /** @} */
+
+    /** Append a micro-operation that has no result. */
+    void append(const MicroOp&);
+
+    /** Append a micro-operation and return a value for its new result slot. */
+    BaseSemantics::SValuePtr appendWithResult(MicroOp, size_t resultWidth);
+
+public:
+    virtual BaseSemantics::SValuePtr undefined_(size_t nbits) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr unspecified_(size_t nbits) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr number_(size_t nbits, uint64_t value) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr boolean_(bool value) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr bottom_(size_t nbits) ROSE_OVERRIDE;
+
+    virtual BaseSemantics::SValuePtr filterCallTarget(const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr filterReturnTarget(const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr filterIndirectJumpTarget(const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual void hlt() ROSE_OVERRIDE;
+    virtual void cpuid() ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr rdtsc() ROSE_OVERRIDE;
+
+    virtual BaseSemantics::SValuePtr and_(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr or_(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr xor_(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr invert(const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr extract(const BaseSemantics::SValuePtr&, size_t begin_bit, size_t end_bit) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr concat(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr leastSignificantSetBit(const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr mostSignificantSetBit(const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr rotateLeft(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr rotateRight(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr shiftLeft(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr shiftRight(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr shiftRightArithmetic(const BaseSemantics::SValuePtr&,
+                                                          const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr equalToZero(const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr ite(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&,
+                                         const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isEqual(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isNotEqual(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isUnsignedLessThan(const BaseSemantics::SValuePtr&,
+                                                        const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isUnsignedLessThanOrEqual(const BaseSemantics::SValuePtr&,
+                                                               const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isUnsignedGreaterThan(const BaseSemantics::SValuePtr&,
+                                                           const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isUnsignedGreaterThanOrEqual(const BaseSemantics::SValuePtr&,
+                                                                  const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isSignedLessThan(const BaseSemantics::SValuePtr&,
+                                                      const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isSignedLessThanOrEqual(const BaseSemantics::SValuePtr&,
+                                                             const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isSignedGreaterThan(const BaseSemantics::SValuePtr&,
+                                                         const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr isSignedGreaterThanOrEqual(const BaseSemantics::SValuePtr&,
+                                                                const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr unsignedExtend(const BaseSemantics::SValuePtr&, size_t nbits) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr signExtend(const BaseSemantics::SValuePtr&, size_t nbits) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr add(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr subtract(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr addWithCarries(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&,
+                                                    const BaseSemantics::SValuePtr&,
+                                                    BaseSemantics::SValuePtr&/*out*/) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr negate(const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr signedDivide(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr signedModulo(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr signedMultiply(const BaseSemantics::SValuePtr&,
+                                                    const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr unsignedDivide(const BaseSemantics::SValuePtr&,
+                                                    const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr unsignedModulo(const BaseSemantics::SValuePtr&,
+                                                    const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr unsignedMultiply(const BaseSemantics::SValuePtr&,
+                                                      const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+
+    virtual void interrupt(int majr, int minr) ROSE_OVERRIDE;
+
+    virtual BaseSemantics::SValuePtr fpFromInteger(const BaseSemantics::SValuePtr&, SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpToInteger(const BaseSemantics::SValuePtr&, SgAsmFloatType*,
+                                                 const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpConvert(const BaseSemantics::SValuePtr&, SgAsmFloatType*, SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpIsNan(const BaseSemantics::SValuePtr&, SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpIsDenormalized(const BaseSemantics::SValuePtr&, SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpIsZero(const BaseSemantics::SValuePtr&, SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpIsInfinity(const BaseSemantics::SValuePtr&, SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpSign(const BaseSemantics::SValuePtr&, SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpEffectiveExponent(const BaseSemantics::SValuePtr&, SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpAdd(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&,
+                                           SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpSubtract(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&,
+                                                SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpMultiply(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&,
+                                                SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpDivide(const BaseSemantics::SValuePtr&, const BaseSemantics::SValuePtr&,
+                                              SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpSquareRoot(const BaseSemantics::SValuePtr&, SgAsmFloatType*) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr fpRoundTowardZero(const BaseSemantics::SValuePtr&, SgAsmFloatType*) ROSE_OVERRIDE;
+
+    virtual BaseSemantics::SValuePtr readRegister(const RegisterDescriptor&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr readRegister(const RegisterDescriptor&,
+                                                  const BaseSemantics::SValuePtr &dflt) ROSE_OVERRIDE;
+    virtual void writeRegister(const RegisterDescriptor&, const BaseSemantics::SValuePtr&) ROSE_OVERRIDE;
+    virtual BaseSemantics::SValuePtr readMemory(const RegisterDescriptor &segreg, const BaseSemantics::SValuePtr &addr,
+                                                const BaseSemantics::SValuePtr &dflt,
+                                                const BaseSemantics::SValuePtr &cond) ROSE_OVERRIDE;
+    virtual void writeMemory(const RegisterDescriptor &segreg, const BaseSemantics::SValuePtr &addr,
+                             const BaseSemantics::SValuePtr &data, const BaseSemantics::SValuePtr &cond) ROSE_OVERRIDE;
+
+protected:
+    BaseSemantics::SValuePtr unary(Opcode, const BaseSemantics::SValuePtr &a, size_t resultWidth);
+    BaseSemantics::SValuePtr binary(Opcode, const BaseSemantics::SValuePtr &a, const BaseSemantics::SValuePtr &b,
+                                    size_t resultWidth);
+    BaseSemantics::SValuePtr floatingPoint(Opcode, const BaseSemantics::SValuePtr &a, const BaseSemantics::SValuePtr &b,
+                                           SgAsmFloatType*, size_t resultWidth);
+};
+
+} // namespace
+} // namespace
+} // namespace
+} // namespace
+
+#endif
@@ -21,6 +21,10 @@ typedef boost::shared_ptr<class RegisterStateGeneric> RegisterStateGenericPtr;
  *  concatenated back to 64-bit values. This splitting and concatenation occurs on a per-register basis at the time the
  *  register is read or written.
  *
+ *  Reading or writing a register that is stored exactly (the common case when an analysis uses registers consistently) is
+ *  handled without any splitting or concatenation: the register's storage list is found through a per-dictionary @ref
+ *  SlotTable and the value is returned or replaced directly.
+ *
  *  The register state also stores optional information about writers for each register. Writer information (addresses of
  *  instructions that wrote to the register) are stored as sets defined at each bit of the register. This allows a wide
  *  register, like x86 RAX, to be written to in parts by different instructions, like x86 AL.  The register state itself
@@ -81,6 +85,37 @@ public:
     /** Values for all registers. */
     typedef Sawyer::Container::Map<RegStore, RegPairs> Registers;
 
+    /** Slot numbers for register storage lists.
+     *
+     *  Assigns a small integer to each major/minor pair that appears in a register dictionary so that the storage list for a
+     *  register can be found by indexing a vector rather than searching the @ref Registers map. All registers that have the
+     *  same major/minor pair (e.g., x86 AL, AH, AX, EAX, and RAX) have the same slot, which is therefore also the precomputed
+     *  set of registers that might overlap with one another.  A slot table is built once per register dictionary and shared by
+     *  all register states that use that dictionary.  Registers whose major/minor pair isn't in the table have no slot and are
+     *  found by searching the map instead. */
+    class SlotTable {
+        std::vector<std::vector<size_t> > slots_;       // slot number indexed by major then minor number
+        size_t nSlots_;
+    public:
+        /** Slot number for registers that have no slot. */
+        static const size_t NO_SLOT = (size_t)(-1);
+
+        /** Build a slot table for the registers of a dictionary. */
+        explicit SlotTable(const RegisterDictionary*);
+
+        /** Number of slots. */
+        size_t nSlots() const { return nSlots_; }
+
+        /** Slot number for a register, or @ref NO_SLOT. */
+        size_t slot(const RegisterDescriptor &reg) const {
+            unsigned majr = reg.get_major(), minr = reg.get_minor();
+            return majr < slots_.size() && minr < slots_[majr].size() ? slots_[majr][minr] : NO_SLOT;
+        }
+    };
+
+    /** Shared-ownership pointer to a slot table. */
+    typedef boost::shared_ptr<const SlotTable> SlotTablePtr;
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Types for Boolean properties
@@ -121,6 +156,8 @@ private:
     RegisterAddressSet writers_;                        // Writing instruction address set for each bit of each register
     bool accessModifiesExistingLocations_;              // Can read/write modify existing locations?
     bool accessCreatesLocations_;                       // Can new locations be created?
+    SlotTablePtr slotTable_;                            // Slot numbers for the storage lists, shared per dictionary
+    std::vector<RegPairs*> slotLists_;                  // Storage list per slot; null if not looked up yet
 
 protected:
     /** Values for registers that have been accessed.
@@ -130,7 +167,10 @@ protected:
      *  overlap only with those registers on the matching major-minor list, if it overlaps at all.  The lists are typically
      *  short (e.g., one list might refer to all the parts of the x86 RAX register, but the RBX parts would be on a different
      *  list. None of the registers stored on a particular list overlap with any other register on that same list; when adding
-     *  new register that would overlap, the registers with which it overlaps must be removed first. */
+     *  new register that would overlap, the registers with which it overlaps must be removed first.
+     *
+     *  The @ref readRegister and @ref writeRegister methods remember where each list lives in this map (see @ref SlotTable),
+     *  so lists are never erased from the map except by @ref clear. */
     Registers registers_;
 
 
@@ -141,16 +181,23 @@ protected:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 protected:
     explicit RegisterStateGeneric(const SValuePtr &protoval, const RegisterDictionary *regdict)
-        : RegisterState(protoval, regdict), accessModifiesExistingLocations_(true), accessCreatesLocations_(true) {
+        : RegisterState(protoval, regdict), accessModifiesExistingLocations_(true), accessCreatesLocations_(true),
+          slotTable_(slotTable(regdict)) {
         clear();
     }
 
     RegisterStateGeneric(const RegisterStateGeneric &other)
         : RegisterState(other), properties_(other.properties_), writers_(other.writers_),
-          accessModifiesExistingLocations_(true), accessCreatesLocations_(true), registers_(other.registers_) {
+          accessModifiesExistingLocations_(true), accessCreatesLocations_(true), slotTable_(other.slotTable_),
+          slotLists_(other.slotLists_.size(), (RegPairs*)NULL), registers_(other.registers_) {
         deep_copy_values();
     }
 
+private:
+    // Not implemented: slotLists_ points into registers_, so a member-wise assignment would leave it pointing into the
+    // source object's map.
+    RegisterStateGeneric& operator=(const RegisterStateGeneric&);
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Static allocating constructors
@@ -591,6 +638,12 @@ protected:
                                     RegPairs &accessedParts /*out*/, RegPairs &preservedParts /*out*/);
 
     void assertStorageConditions(const std::string &where, const RegisterDescriptor &what) const;
+
+    // Slot table for a register dictionary, built the first time it's requested.
+    static SlotTablePtr slotTable(const RegisterDictionary*);
+
+    // Storage list for the register's major/minor pair.  Returns null if there is no list, unless createList is set.
+    RegPairs* storageList(const RegisterDescriptor&, bool createList);
 };
 
 } // namespace
@@ -13,7 +13,11 @@
 #include <string>
 #include <functional>
 #include <queue>
+#include <map>
+#include <vector>
 #include <boost/foreach.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
 #include <boost/unordered_map.hpp>
 
 class FunctionData;
@@ -82,7 +86,66 @@ namespace CallTargetSet
   SgFunctionDeclaration * getFirstVirtualFunctionDefinitionFromAncestors(SgClassType *crtClass, 
                                    SgMemberFunctionDeclaration *memberFunctionDeclaration, 
                                    ClassHierarchyWrapper *classHierarchy);
-  
+
+  /** Memoized call target resolution.
+   *
+   *  Resolving a polymorphic member function call searches the class hierarchy for overriders, and resolving a call through a
+   *  function pointer scans the memory pool for all functions whose type matches.  A call graph asks the same questions for
+   *  every call site, so this cache remembers the answers per (class, member function), per (class, member function type) for
+   *  calls through pointers to members, and per function type signature.  The
+   *  function-type index is built with a single memory pool pass the first time a function pointer call is resolved.
+   *
+   *  All methods are thread-safe provided that other threads don't query the AST at the same time. Cache misses are computed
+   *  while holding the cache's lock because the AST queries they perform (expression types, mangled names, class hierarchy
+   *  lookups) are not thread-safe themselves. */
+  class ROSE_DLL_API CallTargetCache
+  {
+    public:
+      explicit CallTargetCache(ClassHierarchyWrapper *classHierarchy);
+
+      ClassHierarchyWrapper* get_classHierarchy() const { return classHierarchy; }
+
+      //! Memoized version of @ref CallTargetSet::solveMemberFunctionCall.
+      std::vector<SgFunctionDeclaration*> solveMemberFunctionCall(SgClassType *crtClass,
+                                                                  SgMemberFunctionDeclaration *memberFunctionDeclaration,
+                                                                  bool polymorphic, bool includePureVirtualFunc = false);
+
+      //! Memoized version of @ref CallTargetSet::solveMemberFunctionPointerCall. The targets depend only on the class type
+      //! of the object, the member function type of the pointer, and whether the object is @c this.
+      std::vector<SgFunctionDeclaration*> solveMemberFunctionPointerCall(SgExpression *functionExp);
+
+      //! All functions whose type matches @p functionType. If @p nondefiningOnly is set then only first non-defining
+      //! declarations are returned, otherwise every matching declaration found in the memory pool is returned.
+      std::vector<SgFunctionDeclaration*> solveFunctionPointerCall(SgFunctionType *functionType, bool nondefiningOnly);
+
+      //! Number of cache hits and misses, for diagnostics.
+      std::pair<size_t, size_t> statistics();
+
+    private:
+      void buildFunctionTypeIndex();
+
+      typedef boost::tuple<SgClassType*, SgMemberFunctionDeclaration*, bool, bool> MemberCallKey;
+      typedef std::map<MemberCallKey, std::vector<SgFunctionDeclaration*> > MemberCallTargets;
+      typedef boost::tuple<SgType*, SgType*, bool> MemberPointerCallKey;
+      typedef std::map<MemberPointerCallKey, std::vector<SgFunctionDeclaration*> > MemberPointerCallTargets;
+      typedef boost::unordered_map<SgFunctionType*, std::string> FunctionTypeNames;
+      typedef boost::unordered_map<std::string, std::vector<SgFunctionDeclaration*> > FunctionsByType;
+
+      boost::mutex mutex;                               // protects all following data members
+      ClassHierarchyWrapper *classHierarchy;
+      MemberCallTargets memberCallTargets;              // virtual dispatch target sets
+      MemberPointerCallTargets memberPointerCallTargets;// pointer-to-member-function call target sets
+      FunctionTypeNames functionTypeNames;              // mangled name for each function type seen so far
+      FunctionsByType functionsByType;                  // all function declarations indexed by mangled type
+      bool functionTypeIndexBuilt;
+      size_t nHits, nMisses;
+  };
+
+  //! Same as above, but resolves virtual and function pointer calls through the specified cache.
+  ROSE_DLL_API void getPropertiesForExpression(SgExpression* exp,
+                                               CallTargetCache &cache,
+                                               Rose_STL_Container<SgFunctionDeclaration*>& propList,
+                                               bool includePureVirtualFunc = false);
 };
 
 class ROSE_DLL_API FunctionData
@@ -126,6 +189,16 @@ class ROSE_DLL_API CallGraphBuilder
     //! Builder accepting user defined predicate to filter certain functions
     template<typename Predicate>
       void buildCallGraph(Predicate pred);
+    //! Parallel builder filtering nothing in the call graph.
+    void buildCallGraphParallel(size_t nThreads = 0);
+    //! Parallel builder accepting a user defined predicate.
+    //!
+    //! Call sites of the selected functions are found and their types are computed serially, then their targets are looked
+    //! up by up to @p nThreads worker threads (zero means use the hardware concurrency), sharing memoized virtual-dispatch
+    //! and function-pointer target sets. The predicate is only invoked from the calling thread, and the graph is assembled at
+    //! the end in the same order as @ref buildCallGraph, so both builders produce identical graphs.
+    template<typename Predicate>
+      void buildCallGraphParallel(Predicate pred, size_t nThreads = 0);
     //! Grab the call graph built
     SgIncidenceDirectedGraph *getGraph(); 
     //void classifyCallGraph();
@@ -140,6 +213,21 @@ class ROSE_DLL_API CallGraphBuilder
     typedef boost::unordered_map<SgFunctionDeclaration*, SgGraphNode*> GraphNodes;
     GraphNodes graphNodes;
 
+    // Adds constraints to a user predicate. It makes no sense to analyze non-instantiated templates.
+    template<typename Predicate>
+    struct IsSelected {
+        Predicate &pred;
+        IsSelected(Predicate &pred): pred(pred) {}
+        bool operator()(SgNode *node) {
+            SgFunctionDeclaration *f = isSgFunctionDeclaration(node);
+            assert(!f || f==f->get_firstNondefiningDeclaration()); // node uniqueness test
+            return f && !isSgTemplateMemberFunctionDeclaration(f) && !isSgTemplateFunctionDeclaration(f) && pred(f);
+        }
+    };
+
+    // Resolves the callees of each function using nThreads worker threads. The returned lists are parallel to functions.
+    void resolveCallees(const std::vector<SgFunctionDeclaration*> &functions, ClassHierarchyWrapper *classHierarchy,
+                        size_t nThreads, std::vector<Rose_STL_Container<SgFunctionDeclaration*> > &callees /*out*/);
 };
 //! Generate a dot graph named 'fileName' from a call graph 
 //TODO this function is not defined? If so, need to be removed. 
@@ -156,16 +244,7 @@ template<typename Predicate>
 void
 CallGraphBuilder::buildCallGraph(Predicate pred)
 {
-    // Adds additional constraints to the predicate. It makes no sense to analyze non-instantiated templates.
-    struct isSelected {
-        Predicate &pred;
-        isSelected(Predicate &pred): pred(pred) {}
-        bool operator()(SgNode *node) {
-            SgFunctionDeclaration *f = isSgFunctionDeclaration(node);
-            assert(!f || f==f->get_firstNondefiningDeclaration()); // node uniqueness test
-            return f && !isSgTemplateMemberFunctionDeclaration(f) && !isSgTemplateFunctionDeclaration(f) && pred(f);
-        }
-    };
+    IsSelected<Predicate> isSelected(pred);
 
     // Add nodes to the graph by querying the memory pool for function declarations, mapping them to unique declarations
     // that can be used as keys in a map (using get_firstNondefiningDeclaration()), and filtering according to the predicate.
@@ -179,7 +258,7 @@ CallGraphBuilder::buildCallGraph(Predicate pred)
     BOOST_FOREACH(SgNode *node, fdecl_nodes) {
         SgFunctionDeclaration *fdecl = isSgFunctionDeclaration(node);
         SgFunctionDeclaration *unique = isSgFunctionDeclaration(fdecl->get_firstNondefiningDeclaration());
-        if (isSelected(pred)(unique) && graphNodes.find(unique)==graphNodes.end()) {
+        if (isSelected(unique) && graphNodes.find(unique)==graphNodes.end()) {
             FunctionData fdata(unique, project, &classHierarchy); // computes functions called by unique
             callGraphData.push_back(fdata);
             std::string functionName = unique->get_qualified_name().getString();
@@ -195,7 +274,54 @@ CallGraphBuilder::buildCallGraph(Predicate pred)
         SgGraphNode *srcNode = graphNodes.find(currentFunction.functionDeclaration)->second; // we inserted it above
         std::vector<SgFunctionDeclaration*> &callees = currentFunction.functionList;
         BOOST_FOREACH(SgFunctionDeclaration *callee, callees) {
-            if (isSelected(pred)(callee)) {
+            if (isSelected(callee)) {
+                GraphNodes::iterator dstNodeFound = graphNodes.find(callee);
+                assert(dstNodeFound!=graphNodes.end()); // should have been added above
+                SgGraphNode *dstNode = dstNodeFound->second;
+                if (graph->checkIfDirectedGraphEdgeExists(srcNode, dstNode) == false)
+                    graph->addDirectedEdge(srcNode, dstNode);
+            }
+        }
+    }
+}
+
+template<typename Predicate>
+void
+CallGraphBuilder::buildCallGraphParallel(Predicate pred, size_t nThreads)
+{
+    IsSelected<Predicate> isSelected(pred);
+
+    // Select functions and create their nodes serially, in the same order as buildCallGraph. Neither the predicate nor the
+    // graph is assumed to be thread-safe.
+    graph = new SgIncidenceDirectedGraph();
+    ClassHierarchyWrapper classHierarchy(project);
+    graphNodes.clear();
+    VariantVector vv(V_SgFunctionDeclaration);
+    GetOneFuncDeclarationPerFunction defFunc;
+    std::vector<SgNode*> fdecl_nodes = NodeQuery::queryMemoryPool(defFunc, &vv);
+    std::vector<SgFunctionDeclaration*> functions;
+    BOOST_FOREACH(SgNode *node, fdecl_nodes) {
+        SgFunctionDeclaration *fdecl = isSgFunctionDeclaration(node);
+        SgFunctionDeclaration *unique = isSgFunctionDeclaration(fdecl->get_firstNondefiningDeclaration());
+        if (isSelected(unique) && graphNodes.find(unique)==graphNodes.end()) {
+            functions.push_back(unique);
+            std::string functionName = unique->get_qualified_name().getString();
+            SgGraphNode *graphNode = new SgGraphNode(functionName);
+            graphNode->set_SgNode(unique);
+            graphNodes[unique] = graphNode;
+            graph->addNode(graphNode);
+        }
+    }
+
+    // Resolve callees in parallel
+    std::vector<Rose_STL_Container<SgFunctionDeclaration*> > callees;
+    resolveCallees(functions, &classHierarchy, nThreads, callees);
+
+    // Add edges to the graph
+    for (size_t i=0; i<functions.size(); ++i) {
+        SgGraphNode *srcNode = graphNodes.find(functions[i])->second; // we inserted it above
+        BOOST_FOREACH(SgFunctionDeclaration *callee, callees[i]) {
+            if (isSelected(callee)) {
                 GraphNodes::iterator dstNodeFound = graphNodes.find(callee);
                 assert(dstNodeFound!=graphNodes.end()); // should have been added above
                 SgGraphNode *dstNode = dstNodeFound->second;
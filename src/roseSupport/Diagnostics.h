@@ -158,6 +158,13 @@ namespace rose {
  *  SAWER_MESG(mlog[INFO]) <<"loading \"" <<filename <<"\"\n";
  * @endcode
  *
+ *  In inner loops prefer SAWYER_LOG(), which looks up the stream only once and checks whether it's enabled without acquiring
+ *  any lock:
+ *
+ * @code
+ *  SAWYER_LOG(mlog[DEBUG]) <<"processing vertex " <<vertex->id() <<"\n";
+ * @endcode
+ *
  *  Another thing you can do is construct a new locally-declared stream with a shorter name.  Some parts of the ROSE library do
  *  things like this:
  *
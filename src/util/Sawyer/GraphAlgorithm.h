@@ -15,9 +15,15 @@
 #include <Sawyer/GraphTraversal.h>
 #include <Sawyer/Message.h>
 #include <Sawyer/Set.h>
+#include <Sawyer/Stopwatch.h>
+#include <Sawyer/ThreadWorkers.h>
 
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <deque>
 #include <iostream>
 #include <set>
 #include <vector>
@@ -344,6 +350,9 @@ public:
  *  callback and/or predicate. Finally, invoke the @ref run method. The graphs must not be modified between the time this
  *  solver is created and the @ref run method returns.
  *
+ *  The search can be bounded by a time limit and/or a limit on the number of solutions (see @ref timeLimit and @ref
+ *  solutionLimit), and can be split across multiple threads (see @ref nThreads).
+ *
  *  The following functions are convenient wrappers around this class: @ref findCommonIsomorphicSubgraphs, @ref
  *  findFirstCommonIsomorphicSubgraph, @ref findIsomorphicSubgraphs, @ref findMaximumCommonIsomorphicSubgraphs. */
 template<class Graph,
@@ -362,6 +371,25 @@ class CommonSubgraphIsomorphism {
     size_t maximumSolutionSize_;                        // size of largest permitted solutions
     bool monotonicallyIncreasing_;                      // size of solutions increases
     bool findingCommonSubgraphs_;                       // solutions are subgraphs of both graphs or only second graph?
+    size_t nThreads_;                                   // number of threads to use for searching; zero means hardware
+    double timeLimit_;                                  // maximum search time in seconds; zero means no limit
+    size_t solutionLimit_;                              // maximum number of solutions to report per run
+    size_t nSolutions_;                                 // number of solutions reported by the last run
+    bool budgetExhausted_;                              // whether the last run stopped due to the time or solution limit
+    bool aborted_;                                      // whether the current run has been told to stop
+    size_t nodesUntilBudgetCheck_;                      // search nodes to visit before checkBudget looks at the limits again
+    Stopwatch timer_;                                   // time spent in the current run
+    mutable boost::mutex mutex_;                        // protects the solution state when searching in parallel
+    CommonSubgraphIsomorphism *owner_;                  // for parallel workers, the solver that owns the solution state
+
+    // Per-vertex scratch flags describing edges between each vertex and the most recently added vertex of the solution. These
+    // allow refine() to accept or reject most candidate pairs without searching edge lists.
+    enum { ADJ_OUT = 0x01, ADJ_IN = 0x02 };
+
+    // Number of search nodes between checks of the time limit and, for parallel workers, of the state shared with the other
+    // workers.
+    enum { BUDGET_CHECK_INTERVAL = 1024 };
+    mutable std::vector<unsigned char> adjacency1_, adjacency2_;
 
     class Vam {                                         // Vertex Availability Map
         typedef std::vector<size_t> TargetVertices;     // target vertices in no particular order
@@ -438,7 +466,10 @@ public:
                               EquivalenceP equivalenceP = EquivalenceP())
         : g1(g1), g2(g2), v(g1.nVertices()), w(g2.nVertices()), debug(debug), vNotX(g1.nVertices()),
           solutionProcessor_(solutionProcessor), equivalenceP_(equivalenceP), minimumSolutionSize_(1),
-          maximumSolutionSize_(-1), monotonicallyIncreasing_(false), findingCommonSubgraphs_(true) {}
+          maximumSolutionSize_(-1), monotonicallyIncreasing_(false), findingCommonSubgraphs_(true), nThreads_(1),
+          timeLimit_(0.0), solutionLimit_(-1), nSolutions_(0), budgetExhausted_(false), aborted_(false),
+          nodesUntilBudgetCheck_(0), timer_(false),
+          owner_(NULL), adjacency1_(g1.nVertices(), 0), adjacency2_(g2.nVertices(), 0) {}
 
 private:
     CommonSubgraphIsomorphism(const CommonSubgraphIsomorphism&) {
@@ -537,6 +568,56 @@ public:
     void findingCommonSubgraphs(bool b) { findingCommonSubgraphs_ = b; }
     /** @} */
 
+    /** Property: number of threads.
+     *
+     *  Number of threads that @ref run uses to search for solutions. When more than one thread is used the top of the search
+     *  tree is expanded into independent subtrees which are then searched in parallel by worker threads, each taking the next
+     *  unsearched subtree when it finishes the previous one. The workers share the solution size bounds, so a large solution
+     *  found by one worker (see @ref monotonicallyIncreasing) immediately prunes the search of the others.
+     *
+     *  The solution processor is invoked by only one thread at a time, but not necessarily from the calling thread, and the
+     *  solutions are reported in a different order than a single-threaded search. In the parallel search the processor must
+     *  return @ref CSI_ABORT rather than throw an exception to stop the search. Each worker thread uses its own copy of the
+     *  equivalence predicate, so the predicate's @ref CsiEquivalence::progress "progress" method is invoked on the copies.
+     *
+     *  A value of zero means use as many threads as there is hardware concurrency. The default is one, which searches in the
+     *  calling thread. If %Sawyer is configured without multi-thread support then the search is always single threaded.
+     *
+     * @{ */
+    size_t nThreads() const { return nThreads_; }
+    void nThreads(size_t n) { nThreads_ = n; }
+    /** @} */
+
+    /** Property: time limit.
+     *
+     *  Maximum number of seconds that @ref run spends searching. When the limit is reached the search returns to the caller as
+     *  if the solution processor had returned @ref CSI_ABORT, and @ref budgetExhausted returns true. The limit is checked
+     *  once every thousand or so search steps, so the search may run slightly past it. A value of zero (the default) means
+     *  there is no limit.
+     *
+     * @{ */
+    double timeLimit() const { return timeLimit_; }
+    void timeLimit(double seconds) { timeLimit_ = seconds; }
+    /** @} */
+
+    /** Property: solution limit.
+     *
+     *  Maximum number of solutions that @ref run reports to the solution processor. When the limit is reached the search
+     *  returns to the caller and @ref budgetExhausted returns true. The default is no limit.
+     *
+     * @{ */
+    size_t solutionLimit() const { return solutionLimit_; }
+    void solutionLimit(size_t n) { solutionLimit_ = n; }
+    /** @} */
+
+    /** Number of solutions reported by the most recent @ref run. */
+    size_t nSolutions() const { return nSolutions_; }
+
+    /** Whether the most recent @ref run stopped early because of the time or solution limit.
+     *
+     *  If true, the search space was not completely searched and more solutions may exist. */
+    bool budgetExhausted() const { return budgetExhausted_; }
+
     /** Perform the common subgraph isomorphism analysis.
      *
      *  Runs the common subgraph isomorphism analysis from beginning to end, invoking the constructor-supplied solution
@@ -554,9 +635,16 @@ public:
      *  necessary since the destructor does not leak memory. */
     void run() {
         reset();
+        timer_.restart();
         Vam vam;                                        // this is the only per-recursion local state
         initializeVam(vam);
-        recurse(vam);
+        size_t nThreads = 0 == nThreads_ ? boost::thread::hardware_concurrency() : nThreads_;
+        if (nThreads > 1 && SAWYER_THREAD_TRAITS::SUPPORTED) {
+            runParallel(vam, nThreads);
+        } else {
+            recurse(vam);
+        }
+        timer_.stop();
     }
 
     /** Releases memory used by the analysis.
@@ -564,14 +652,182 @@ public:
      *  Releases memory that's used by the analysis, returning the analysis to its just-constructed state.  This method is
      *  called implicitly at the beginning of each @ref run. */
     void reset() {
+        resetSearch();
+        nSolutions_ = 0;
+        budgetExhausted_ = false;
+        aborted_ = false;
+        nodesUntilBudgetCheck_ = 0;
+    }
+    
+private:
+    // A subtree of the search space: the partial solution, the vertices of G1 that were removed from consideration, and the
+    // vertex availability map at that point of the search.
+    struct SearchTask {
+        std::vector<size_t> x, y;
+        std::vector<size_t> removed;
+        Vam vam;
+
+        SearchTask() {}
+        SearchTask(const std::vector<size_t> &x, const std::vector<size_t> &y, const std::vector<size_t> &removed,
+                   const Vam &vam)
+            : x(x), y(y), removed(removed), vam(vam) {}
+    };
+
+    // Worker thread functor for the parallel search. Each task is searched by its own solver whose solutions are reported
+    // through the solver that owns the run.
+    class SearchWorker;
+    friend class SearchWorker;
+
+    class SearchWorker {
+        CommonSubgraphIsomorphism *owner_;
+    public:
+        explicit SearchWorker(CommonSubgraphIsomorphism *owner)
+            : owner_(owner) {}
+
+        void operator()(size_t /*taskId*/, const SearchTask &task) {
+            boost::scoped_ptr<CommonSubgraphIsomorphism> worker;
+            {
+                boost::lock_guard<boost::mutex> lock(owner_->mutex_);
+                if (owner_->aborted_)
+                    return;
+                worker.reset(new CommonSubgraphIsomorphism(owner_->g1, owner_->g2, owner_->debug,
+                                                           owner_->solutionProcessor_, owner_->equivalenceP_));
+                worker->minimumSolutionSize_ = owner_->minimumSolutionSize_;
+                worker->maximumSolutionSize_ = owner_->maximumSolutionSize_;
+                worker->monotonicallyIncreasing_ = owner_->monotonicallyIncreasing_;
+                worker->findingCommonSubgraphs_ = owner_->findingCommonSubgraphs_;
+                worker->timeLimit_ = owner_->timeLimit_;
+                worker->owner_ = owner_;
+            }
+            worker->loadState(task);
+            worker->recurse(task.vam, task.x.size());
+        }
+    };
+
+    // Expand the top of the search tree breadth-first into independent subtrees and search them in parallel.
+    void runParallel(const Vam &vam, size_t nThreads) {
+        std::deque<SearchTask> frontier;
+        frontier.push_back(SearchTask(x, y, std::vector<size_t>(), vam));
+        const size_t targetTasks = 16 * nThreads;       // enough tasks to keep all threads busy until the end
+        while (!frontier.empty() && frontier.size() < targetTasks) {
+            if (checkBudget() == CSI_ABORT)
+                return;
+            SearchTask task = frontier.front();
+            frontier.pop_front();
+            loadState(task);
+            if (!isSolutionPossible(task.vam)) {
+                if (isSolutionValidSize() && reportSolution() == CSI_ABORT)
+                    return;
+                continue;
+            }
+            size_t i = pickVertex(task.vam);
+            std::vector<size_t> jCandidates = task.vam.get(i);
+            BOOST_FOREACH (size_t j, jCandidates) {
+                extendSolution(i, j);
+                frontier.push_back(SearchTask(x, y, task.removed, refine(task.vam)));
+                retractSolution();
+            }
+            if (findingCommonSubgraphs_) {
+                task.removed.push_back(i);
+                frontier.push_back(task);
+            }
+        }
+
+        if (!frontier.empty()) {
+            // The tasks have no dependencies. They're inserted in reverse order because the workers take the most recently
+            // inserted task first, and the front of the frontier is where the serial search would have gone first (and
+            // therefore where a large solution that raises the bound for the other workers is most likely to be found).
+            Container::Graph<SearchTask> tasks;
+            for (typename std::deque<SearchTask>::reverse_iterator task = frontier.rbegin(); task != frontier.rend(); ++task)
+                tasks.insertVertex(*task);
+            frontier.clear();
+            workInParallel(tasks, nThreads, SearchWorker(this));
+        }
+        resetSearch();
+    }
+
+    // Reset the search state without resetting the statistics for the run.
+    void resetSearch() {
         v.insertAll();
         w.insertAll();
         x.clear();
         y.clear();
         vNotX.insertAll();
     }
-    
-private:
+
+    // Set the search state to the root of the specified subtree.
+    void loadState(const SearchTask &task) {
+        resetSearch();
+        x = task.x;
+        y = task.y;
+        BOOST_FOREACH (size_t i, task.removed) {
+            v.erase(i);
+            vNotX.erase(i);
+        }
+        BOOST_FOREACH (size_t i, x)
+            vNotX.erase(i);
+    }
+
+    // Check the time limit and whether another thread has stopped the search. For parallel workers, also obtain the latest
+    // minimum solution size found by any worker. This is called for every search node, but it reads the timer and the owner's
+    // state only every BUDGET_CHECK_INTERVAL nodes so that the workers don't serialize on the owner's mutex.
+    CsiNextAction checkBudget() {
+        if (aborted_)
+            return CSI_ABORT;
+        if (nodesUntilBudgetCheck_ > 0) {
+            --nodesUntilBudgetCheck_;
+            return CSI_CONTINUE;
+        }
+        nodesUntilBudgetCheck_ = BUDGET_CHECK_INTERVAL - 1;
+
+        if (NULL == owner_) {
+            if (timeLimit_ > 0.0 && timer_.report() >= timeLimit_) {
+                budgetExhausted_ = aborted_ = true;
+                return CSI_ABORT;
+            }
+            return CSI_CONTINUE;
+        }
+        boost::lock_guard<boost::mutex> lock(owner_->mutex_);
+        if (!owner_->aborted_ && timeLimit_ > 0.0 && owner_->timer_.report() >= timeLimit_)
+            owner_->budgetExhausted_ = owner_->aborted_ = true;
+        if (owner_->minimumSolutionSize_ > minimumSolutionSize_)
+            minimumSolutionSize_ = owner_->minimumSolutionSize_;
+        if (owner_->aborted_)
+            aborted_ = true;
+        return aborted_ ? CSI_ABORT : CSI_CONTINUE;
+    }
+
+    // Report the current solution (x, y) to the solution processor. Parallel workers report through the owning solver.
+    CsiNextAction reportSolution() {
+        if (NULL == owner_)
+            return acceptSolution(x, y);
+        boost::lock_guard<boost::mutex> lock(owner_->mutex_);
+        CsiNextAction action = owner_->acceptSolution(x, y);
+        minimumSolutionSize_ = owner_->minimumSolutionSize_;
+        return action;
+    }
+
+    // Invoke the solution processor and update the solution statistics and limits. In the parallel search this is called with
+    // the mutex held.
+    CsiNextAction acceptSolution(const std::vector<size_t> &x, const std::vector<size_t> &y) {
+        if (aborted_)
+            return CSI_ABORT;
+        if (monotonicallyIncreasing_) {
+            if (x.size() < minimumSolutionSize_)
+                return CSI_CONTINUE;                    // another worker already found a larger solution
+            minimumSolutionSize_ = x.size();
+        }
+        ++nSolutions_;
+        CsiNextAction action = solutionProcessor_(g1, x, g2, y);
+        if (nSolutions_ >= solutionLimit_) {
+            budgetExhausted_ = true;
+            action = CSI_ABORT;
+        }
+        if (CSI_ABORT == action)
+            aborted_ = true;
+        return action;
+    }
+
     // Print contents of a container. This is only used for debugging.
     template<class ForwardIterator>
     void printContainer(std::ostream &out, const std::string &prefix, ForwardIterator begin, const ForwardIterator &end,
@@ -719,15 +975,39 @@ private:
         return equivalenceP_.nu(g1, v1, v2, edges1, g2, w1, w2, edges2);
     }
 
+    // Set or clear the adjacency flags for the neighbors of a vertex.
+    static void
+    markAdjacent(const Graph &g, size_t vertexId, std::vector<unsigned char> &adjacency /*in,out*/, bool set) {
+        typename Graph::ConstVertexIterator vertex = g.findVertex(vertexId);
+        BOOST_FOREACH (const typename Graph::Edge &edge, vertex->outEdges())
+            adjacency[edge.target()->id()] = set ? adjacency[edge.target()->id()] | ADJ_OUT : 0;
+        BOOST_FOREACH (const typename Graph::Edge &edge, vertex->inEdges())
+            adjacency[edge.source()->id()] = set ? adjacency[edge.source()->id()] | ADJ_IN : 0;
+    }
+
     // Create a new VAM from an existing one. The (i,j) pairs of the new VAM will form a subset of the specified VAM.
     Vam refine(const Vam &vam) const {
+        // Flag the vertices adjacent to the newest solution pair. A pair (i,j) where one vertex is adjacent and the other isn't
+        // can't be suitable since the edge counts differ, and a pair where neither is adjacent is always suitable. Only pairs
+        // that are both adjacent need their edges compared.
+        markAdjacent(g1, x.back(), adjacency1_, true);
+        markAdjacent(g2, y.back(), adjacency2_, true);
+
         Vam refined;
         BOOST_FOREACH (size_t i, vNotX.values()) {
             BOOST_FOREACH (size_t j, vam.get(i)) {
                 if (j != y.back()) {
                     SAWYER_MESG(debug) <<"  refining with edges " <<x.back() <<" <--> " <<i <<" in G1"
                                        <<" and " <<y.back() <<" <--> " <<j <<" in G2";
-                    if (edgesAreSuitable(x.back(), i, y.back(), j)) {
+                    bool suitable = false;
+                    if (adjacency1_[i] != adjacency2_[j]) {
+                        suitable = false;
+                    } else if (0 == adjacency1_[i]) {
+                        suitable = true;
+                    } else {
+                        suitable = edgesAreSuitable(x.back(), i, y.back(), j);
+                    }
+                    if (suitable) {
                         SAWYER_MESG(debug) <<": inserting (" <<i <<", " <<j <<")\n";
                         refined.insert(i, j);
                     } else {
@@ -736,6 +1016,9 @@ private:
                 }
             }
         }
+
+        markAdjacent(g1, x.back(), adjacency1_, false);
+        markAdjacent(g2, y.back(), adjacency2_, false);
         refined.print(debug, "  refined");
         return refined;
     }
@@ -764,6 +1047,8 @@ private:
     // advanced and retracted as the space is searched. The VAM is the only part of the state that needs to be stored on a
     // stack since changes to it could not be easily undone during the retract phase.
     CsiNextAction recurse(const Vam &vam, size_t level = 0) {
+        if (checkBudget() == CSI_ABORT)
+            return CSI_ABORT;
         if (debug)
             showState(vam, "entering state", level);        // debugging
         equivalenceP_.progress(level);
@@ -800,9 +1085,7 @@ private:
                 printContainer(debug, "  found soln x = ", x.begin(), x.end());
                 printContainer(debug, "  found soln y = ", y.begin(), y.end());
             }
-            if (monotonicallyIncreasing_)
-                minimumSolutionSize_ = x.size();
-            if (solutionProcessor_(g1, x, g2, y) == CSI_ABORT)
+            if (reportSolution() == CSI_ABORT)
                 return CSI_ABORT;
         }
         return CSI_CONTINUE;
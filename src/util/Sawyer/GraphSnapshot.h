@@ -0,0 +1,339 @@
+// WARNING: Changes to this file must be contributed back to Sawyer or else they will
+//          be clobbered by the next update from Sawyer.  The Sawyer repository is at
+//          https://github.com/matzke1/sawyer.
+
+
+
+
+// Immutable compressed sparse row view of a Sawyer::Container::Graph
+#ifndef Sawyer_GraphSnapshot_H
+#define Sawyer_GraphSnapshot_H
+
+#include <Sawyer/Sawyer.h>
+#include <Sawyer/Assert.h>
+#include <boost/foreach.hpp>
+#include <boost/range/iterator_range.hpp>
+#include <utility>
+#include <vector>
+
+namespace Sawyer {
+namespace Container {
+
+/** Immutable compressed sparse row snapshot of a graph.
+ *
+ *  A @ref Graph stores its vertices in an indexed list and its edges in intrusive doubly linked lists, which makes it cheap to
+ *  modify but means that every traversal chases pointers.  Many graphs (control flow graphs, function call graphs, etc.) are
+ *  built once and then traversed many times, and for those it pays to take a snapshot of the graph's connectivity: each
+ *  vertex's out-neighbors and in-neighbors are stored contiguously in arrays indexed by the vertex ID number.
+ *
+ *  The snapshot refers to vertices and edges by their ID numbers, which are the same ID numbers used by the graph from which
+ *  the snapshot was taken.  The original vertex and edge iterators can be obtained from the snapshot with @ref vertex and @ref
+ *  edge.  The snapshot does not observe later changes to the graph; modifying the graph (other than modifying vertex and
+ *  edge values) invalidates the snapshot, which should then be rebuilt.
+ *
+ *  The neighbors of a vertex are listed in the same order as the vertex's edges in the graph, and a vertex is listed once for
+ *  each edge, so parallel edges result in repeated neighbors.
+ *
+ *  Example:
+ *
+ * @code
+ *  typedef Sawyer::Container::Graph<std::string> MyGraph;
+ *  MyGraph g = ...;
+ *  Sawyer::Container::GraphSnapshot<MyGraph> snapshot(g);
+ *  BOOST_FOREACH (size_t targetId, snapshot.outVertices(0))
+ *      std::cout <<snapshot.vertex(targetId)->value() <<"\n";
+ *  std::vector<size_t> idom = snapshot.immediateDominators(0);
+ * @endcode */
+template<class G>
+class GraphSnapshot {
+public:
+    typedef G Graph;                                    /**< Type of graph from which the snapshot was taken. */
+    typedef typename G::ConstVertexIterator ConstVertexIterator; /**< Iterator referencing an original vertex. */
+    typedef typename G::ConstEdgeIterator ConstEdgeIterator; /**< Iterator referencing an original edge. */
+    typedef boost::iterator_range<const size_t*> IdRange; /**< Contiguous range of vertex or edge ID numbers. */
+
+    /** Direction in which edges are followed. */
+    enum Direction {
+        FORWARD,                                        /**< Follow edges from their source to their target. */
+        REVERSE                                         /**< Follow edges from their target to their source. */
+    };
+
+    /** Value indicating the absence of a vertex. */
+    static const size_t NO_VERTEX = (size_t)(-1);
+
+private:
+    std::vector<size_t> outOffsets_;                    // index into outVertices_ and outEdges_ for each vertex, plus one
+    std::vector<size_t> outVertices_;                   // target vertex ID for each out-edge, grouped by source vertex
+    std::vector<size_t> outEdges_;                      // edge ID for each out-edge, grouped by source vertex
+    std::vector<size_t> inOffsets_;                     // index into inVertices_ and inEdges_ for each vertex, plus one
+    std::vector<size_t> inVertices_;                    // source vertex ID for each in-edge, grouped by target vertex
+    std::vector<size_t> inEdges_;                       // edge ID for each in-edge, grouped by target vertex
+    std::vector<ConstVertexIterator> vertices_;         // original vertex for each vertex ID
+    std::vector<ConstEdgeIterator> edges_;              // original edge for each edge ID
+
+public:
+    /** Construct an empty snapshot. */
+    GraphSnapshot() {
+        outOffsets_.push_back(0);
+        inOffsets_.push_back(0);
+    }
+
+    /** Construct a snapshot of a graph.
+     *
+     *  Time complexity is O(|V|+|E|). */
+    explicit GraphSnapshot(const Graph &g) {
+        build(g);
+    }
+
+    /** Rebuild this snapshot from a graph.
+     *
+     *  Discards the previous contents of the snapshot.  Time complexity is O(|V|+|E|). */
+    void build(const Graph &g) {
+        size_t nv = g.nVertices(), ne = g.nEdges();
+
+        vertices_.clear();
+        vertices_.reserve(nv);
+        for (size_t i=0; i<nv; ++i)
+            vertices_.push_back(g.findVertex(i));
+
+        edges_.clear();
+        edges_.reserve(ne);
+        for (size_t i=0; i<ne; ++i)
+            edges_.push_back(g.findEdge(i));
+
+        outOffsets_.clear();
+        outOffsets_.reserve(nv+1);
+        outVertices_.clear();
+        outVertices_.reserve(ne);
+        outEdges_.clear();
+        outEdges_.reserve(ne);
+        inOffsets_.clear();
+        inOffsets_.reserve(nv+1);
+        inVertices_.clear();
+        inVertices_.reserve(ne);
+        inEdges_.clear();
+        inEdges_.reserve(ne);
+
+        for (size_t i=0; i<nv; ++i) {
+            outOffsets_.push_back(outVertices_.size());
+            BOOST_FOREACH (const typename Graph::Edge &edge, vertices_[i]->outEdges()) {
+                outVertices_.push_back(edge.target()->id());
+                outEdges_.push_back(edge.id());
+            }
+            inOffsets_.push_back(inVertices_.size());
+            BOOST_FOREACH (const typename Graph::Edge &edge, vertices_[i]->inEdges()) {
+                inVertices_.push_back(edge.source()->id());
+                inEdges_.push_back(edge.id());
+            }
+        }
+        outOffsets_.push_back(outVertices_.size());
+        inOffsets_.push_back(inVertices_.size());
+        ASSERT_require(outVertices_.size() == ne);
+        ASSERT_require(inVertices_.size() == ne);
+    }
+
+    /** Number of vertices in the snapshot. */
+    size_t nVertices() const {
+        return vertices_.size();
+    }
+
+    /** Number of edges in the snapshot. */
+    size_t nEdges() const {
+        return edges_.size();
+    }
+
+    /** True if the snapshot has no vertices. */
+    bool isEmpty() const {
+        return vertices_.empty();
+    }
+
+    /** Original vertex for a vertex ID. */
+    ConstVertexIterator vertex(size_t vertexId) const {
+        ASSERT_require(vertexId < vertices_.size());
+        return vertices_[vertexId];
+    }
+
+    /** Original edge for an edge ID. */
+    ConstEdgeIterator edge(size_t edgeId) const {
+        ASSERT_require(edgeId < edges_.size());
+        return edges_[edgeId];
+    }
+
+    /** Number of edges leaving a vertex. */
+    size_t nOutEdges(size_t vertexId) const {
+        ASSERT_require(vertexId < vertices_.size());
+        return outOffsets_[vertexId+1] - outOffsets_[vertexId];
+    }
+
+    /** Number of edges entering a vertex. */
+    size_t nInEdges(size_t vertexId) const {
+        ASSERT_require(vertexId < vertices_.size());
+        return inOffsets_[vertexId+1] - inOffsets_[vertexId];
+    }
+
+    /** Targets of the edges leaving a vertex. */
+    IdRange outVertices(size_t vertexId) const {
+        return range(outVertices_, outOffsets_, vertexId);
+    }
+
+    /** ID numbers of the edges leaving a vertex.
+     *
+     *  These are parallel to @ref outVertices. */
+    IdRange outEdges(size_t vertexId) const {
+        return range(outEdges_, outOffsets_, vertexId);
+    }
+
+    /** Sources of the edges entering a vertex. */
+    IdRange inVertices(size_t vertexId) const {
+        return range(inVertices_, inOffsets_, vertexId);
+    }
+
+    /** ID numbers of the edges entering a vertex.
+     *
+     *  These are parallel to @ref inVertices. */
+    IdRange inEdges(size_t vertexId) const {
+        return range(inEdges_, inOffsets_, vertexId);
+    }
+
+    /** Vertices adjacent to a vertex when following edges in the specified direction. */
+    IdRange neighbors(size_t vertexId, Direction direction) const {
+        return FORWARD == direction ? outVertices(vertexId) : inVertices(vertexId);
+    }
+
+    /** Vertices reachable from a root in depth-first preorder.
+     *
+     *  Returns the ID numbers of the vertices reachable from @p root (including the root) in the order they are first
+     *  discovered by a depth-first traversal that follows edges in the specified direction. */
+    std::vector<size_t> depthFirstPreorder(size_t root, Direction direction = FORWARD) const {
+        std::vector<size_t> preorder, postorder;
+        depthFirst(root, direction, preorder, postorder);
+        return preorder;
+    }
+
+    /** Vertices reachable from a root in depth-first postorder.
+     *
+     *  Returns the ID numbers of the vertices reachable from @p root (including the root) in the order they are finished by
+     *  a depth-first traversal that follows edges in the specified direction. */
+    std::vector<size_t> depthFirstPostorder(size_t root, Direction direction = FORWARD) const {
+        std::vector<size_t> preorder, postorder;
+        depthFirst(root, direction, preorder, postorder);
+        return postorder;
+    }
+
+    /** Vertices reachable from a root in breadth-first order.
+     *
+     *  Returns the ID numbers of the vertices reachable from @p root (including the root) in the order they are discovered by
+     *  a breadth-first traversal that follows edges in the specified direction. */
+    std::vector<size_t> breadthFirstOrder(size_t root, Direction direction = FORWARD) const {
+        ASSERT_require(root < vertices_.size());
+        std::vector<bool> seen(vertices_.size(), false);
+        std::vector<size_t> order;
+        order.reserve(vertices_.size());
+        order.push_back(root);
+        seen[root] = true;
+        for (size_t i=0; i<order.size(); ++i) {
+            BOOST_FOREACH (size_t next, neighbors(order[i], direction)) {
+                if (!seen[next]) {
+                    seen[next] = true;
+                    order.push_back(next);
+                }
+            }
+        }
+        return order;
+    }
+
+    /** Immediate dominators.
+     *
+     *  Returns a vector indexed by vertex ID whose elements are the ID numbers of each vertex's immediate dominator with
+     *  respect to the specified root.  The root and vertices that are not reachable from the root have no immediate dominator
+     *  and their elements are @ref NO_VERTEX.  When the direction is @ref REVERSE the result is the immediate post-dominators
+     *  with respect to the root (which is then typically a function's return vertex).
+     *
+     *  The implementation is the iterative algorithm of Cooper, Harvey, and Kennedy, "A Simple, Fast Dominance Algorithm",
+     *  which is efficient for the shallow, reducible graphs typical of control flow. */
+    std::vector<size_t> immediateDominators(size_t root, Direction direction = FORWARD) const {
+        ASSERT_require(root < vertices_.size());
+        std::vector<size_t> postorder = depthFirstPostorder(root, direction);
+        std::vector<size_t> rank(vertices_.size(), NO_VERTEX); // position of each reachable vertex in postorder
+        for (size_t i=0; i<postorder.size(); ++i)
+            rank[postorder[i]] = i;
+
+        std::vector<size_t> idom(vertices_.size(), NO_VERTEX);
+        idom[root] = root;
+        Direction predecessorDirection = FORWARD == direction ? REVERSE : FORWARD;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            // Process vertices in reverse postorder, skipping the root (which is last in postorder).
+            for (size_t i=postorder.size(); i>1; --i) {
+                size_t vertexId = postorder[i-2];
+                size_t newIdom = NO_VERTEX;
+                BOOST_FOREACH (size_t pred, neighbors(vertexId, predecessorDirection)) {
+                    if (NO_VERTEX == idom[pred])
+                        continue;                       // not reachable, or not processed yet
+                    newIdom = NO_VERTEX == newIdom ? pred : intersect(idom, rank, pred, newIdom);
+                }
+                if (idom[vertexId] != newIdom) {
+                    idom[vertexId] = newIdom;
+                    changed = true;
+                }
+            }
+        }
+        idom[root] = NO_VERTEX;
+        return idom;
+    }
+
+private:
+    static IdRange range(const std::vector<size_t> &ids, const std::vector<size_t> &offsets, size_t vertexId) {
+        ASSERT_require(vertexId+1 < offsets.size());
+        const size_t *base = ids.empty() ? NULL : &ids[0];
+        return IdRange(base + offsets[vertexId], base + offsets[vertexId+1]);
+    }
+
+    // Iterative depth-first traversal producing both pre- and postorder.
+    void depthFirst(size_t root, Direction direction, std::vector<size_t> &preorder, std::vector<size_t> &postorder) const {
+        ASSERT_require(root < vertices_.size());
+        std::vector<bool> seen(vertices_.size(), false);
+        std::vector<std::pair<size_t, size_t> > stack;  // vertex ID and index of the next neighbor to visit
+        preorder.reserve(vertices_.size());
+        postorder.reserve(vertices_.size());
+        stack.push_back(std::make_pair(root, (size_t)0));
+        seen[root] = true;
+        preorder.push_back(root);
+        while (!stack.empty()) {
+            size_t vertexId = stack.back().first;
+            IdRange next = neighbors(vertexId, direction);
+            size_t &nextIdx = stack.back().second;
+            while (nextIdx < (size_t)next.size() && seen[next[nextIdx]])
+                ++nextIdx;
+            if (nextIdx < (size_t)next.size()) {
+                size_t childId = next[nextIdx++];
+                seen[childId] = true;
+                preorder.push_back(childId);
+                stack.push_back(std::make_pair(childId, (size_t)0));
+            } else {
+                postorder.push_back(vertexId);
+                stack.pop_back();
+            }
+        }
+    }
+
+    // Walk up the partial dominator tree from two vertices until they meet.
+    static size_t intersect(const std::vector<size_t> &idom, const std::vector<size_t> &rank, size_t a, size_t b) {
+        while (a != b) {
+            while (rank[a] < rank[b])
+                a = idom[a];
+            while (rank[b] < rank[a])
+                b = idom[b];
+        }
+        return a;
+    }
+};
+
+template<class G>
+const size_t GraphSnapshot<G>::NO_VERTEX;
+
+} // namespace
+} // namespace
+
+#endif
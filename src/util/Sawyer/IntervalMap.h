@@ -802,23 +802,29 @@ public:
     /** Insert a key/value pair.
      *
      *  If @p makeHole is true then the interval being inserted is first erased; otherwise the insertion happens only if none
-     *  of the interval being inserted already exists in the container.  */
+     *  of the interval being inserted already exists in the container.
+     *
+     *  The underlying map is searched at most once (twice if something must be erased), and not at all if the interval is
+     *  greater than everything already in the container, so inserting intervals in ascending order takes amortized constant
+     *  time per interval. */
     void insert(Interval key, Value value, bool makeHole=true) {
         if (key.isEmpty())
             return;
-        if (makeHole) {
-            erase(key);
-        } else {
-            NodeIterator found = lowerBound(key.least());
-            if (found!=nodes().end() && key.isOverlapping(found->key()))
+
+        // The node before which the new node belongs. Since intervals are sorted by their greatest values, this is the first
+        // node that ends at or after the start of the new interval, and it's the right-adjoining node if there is one.
+        NodeIterator next = !isEmpty() && key.least() > greatest() ? nodes().end() : lowerBound(key.least());
+        if (next!=nodes().end() && next->key().least() <= key.greatest()) {
+            if (!makeHole)
                 return;
+            erase(key);
+            next = lowerBound(key.least());
         }
 
-        // Attempt to merge with a left-adjoining node
-        if (key.least() - 1 < key.least()) {
-            NodeIterator left = find(key.least() - 1);
-            if (left!=nodes().end() &&
-                left->key().greatest()+1==key.least() &&
+        // Attempt to merge with a left-adjoining node, which can only be the node before "next".
+        if (next!=nodes().begin()) {
+            NodeIterator left = next; --left;
+            if (left->key().greatest()+1==key.least() &&
                 policy_.merge(left->key(), left->value(), key, value)) {
                 key = Interval::hull(left->key().least(), key.greatest());
                 std::swap(value, left->value());
@@ -828,21 +834,43 @@ public:
         }
 
         // Attempt to merge with a right-adjoining node
-        if (key.greatest() + 1 > key.greatest()) {
-            NodeIterator right = find(key.greatest() + 1);
-            if (right!=nodes().end() &&
-                key.greatest()+1==right->key().least() &&
-                policy_.merge(key, value, right->key(), right->value())) {
-                key = Interval::hull(key.least(), right->key().greatest());
-                size_ -= right->key().size();
-                map_.eraseAt(right);
-            }
+        if (next!=nodes().end() &&
+            key.greatest()+1==next->key().least() &&
+            policy_.merge(key, value, next->key(), next->value())) {
+            key = Interval::hull(key.least(), next->key().greatest());
+            size_ -= next->key().size();
+            NodeIterator right = next++;
+            map_.eraseAt(right);
         }
 
-        map_.insert(key, value);
+        map_.insertHint(next, key, value);
         size_ += key.size();
     }
 
+    /** Build the container from sorted key/value pairs.
+     *
+     *  Replaces the contents of this container with the intervals and values from the specified range, whose elements are
+     *  <code>std::pair</code> objects holding an interval and a value (such as the elements of a vector of pairs).  The
+     *  intervals must be sorted in ascending order and must not overlap.  Adjoining intervals are merged according to the
+     *  policy, just as if they had been inserted one at a time, but the container is built in linear time.
+     *
+     * @{ */
+    template<class PairIterator>
+    void build(PairIterator begin, PairIterator end) {
+        clear();
+        for (/*void*/; begin!=end; ++begin) {
+            ASSERT_require2(isEmpty() || begin->first.isEmpty() || begin->first.least() > greatest(),
+                            "intervals must be sorted and non-overlapping");
+            insert(begin->first, begin->second);
+        }
+    }
+
+    template<class PairIterator>
+    void build(const boost::iterator_range<PairIterator> &range) {
+        build(range.begin(), range.end());
+    }
+    /** @} */
+
     /** Insert values from another container.
      *
      *  The values in the other container must be convertable to values of this container, and the intervals must be the same
@@ -537,6 +537,28 @@ public:
     }
     /** @} */
 
+    /** Build the set from sorted intervals.
+     *
+     *  Replaces the contents of this set with the intervals from the specified range.  The intervals must be sorted in
+     *  ascending order and must not overlap, in which case the set is built in linear time.
+     *
+     * @{ */
+    template<class IntervalIterator>
+    void build(IntervalIterator begin, IntervalIterator end) {
+        map_.clear();
+        for (/*void*/; begin!=end; ++begin) {
+            ASSERT_require2(map_.isEmpty() || begin->isEmpty() || begin->least() > map_.greatest(),
+                            "intervals must be sorted and non-overlapping");
+            map_.insert(*begin, 0);
+        }
+    }
+
+    template<class IntervalIterator>
+    void build(const boost::iterator_range<IntervalIterator> &range) {
+        build(range.begin(), range.end());
+    }
+    /** @} */
+
     /** Remove specified values.
      *
      *  The values can be specified by an interval (or scalar if the interval has an implicit constructor), another set whose
@@ -524,6 +524,20 @@ public:
         return *this;
     }
 
+    /** Insert or update a key/value pair near a known position.
+     *
+     *  This is the same as @ref insert except the caller also supplies a @p hint, namely the node before which the new node
+     *  belongs or the end iterator.  When the hint is correct the insertion takes amortized constant time rather than
+     *  logarithmic time, which makes building a map from sorted input linear.  An incorrect hint still produces the correct
+     *  result. Returns an iterator for the inserted or updated node. */
+    NodeIterator insertHint(const NodeIterator &hint, const Key &key, const Value &value) {
+        size_t oldSize = map_.size();
+        typename StlMap::iterator inserted = map_.insert(hint.base(), std::make_pair(key, value));
+        if (map_.size() == oldSize)
+            inserted->second = value;
+        return NodeIterator(inserted);
+    }
+
     /** Insert or update a key with a default value.
      *
      *  The value associated with @p key in the map is replaced with a default-constructed value.  If the key does not exist
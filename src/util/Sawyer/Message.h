@@ -483,6 +483,7 @@ typedef SharedPointer<class FdSink> FdSinkPtr;
 typedef SharedPointer<class FileSink> FileSinkPtr;
 typedef SharedPointer<class StreamSink> StreamSinkPtr;
 typedef SharedPointer<class SyslogSink> SyslogSinkPtr;
+typedef SharedPointer<class AsyncSink> AsyncSinkPtr;
 /** @} */
 
 /** Baked properties for a destination.  Rather than recompute properties every time characters of a message are inserted into
@@ -1325,6 +1326,80 @@ public:
     virtual void post(const Mesg&, const MesgProps&) /*override*/;
 };
 
+/** Emits messages from a background thread.
+ *
+ *  An asynchronous sink wraps some other final destination (any destination that is not a @ref Multiplexer) and hands each
+ *  incoming message to a background thread which then posts it to the wrapped destination.  The formatting done by the
+ *  wrapped destination (prefixes, colors, etc.) and the actual output therefore happen on the background thread, and the
+ *  thread emitting the message only copies the message into a queue.  Messages are emitted in the order they're posted.
+ *
+ *  Since partial messages would just add traffic to the queue, an asynchronous sink always buffers messages, passing along
+ *  only complete (or interrupted or canceled) messages. Prefixes that contain elapsed times show the time at which the message was emitted by the
+ *  background thread.
+ *
+ *  Producers lock the queue only long enough to append to it, and the background thread swaps out the whole queue at once,
+ *  so producers are almost never blocked by output.  Messages still in the queue are emitted when the sink is destroyed, or
+ *  explicitly by calling @ref flush.  Without multi-threading support this sink posts messages synchronously.
+ *
+ * @code
+ *  using namespace Sawyer::Message;
+ *  DestinationPtr stderrSink = FdSink::instance(2);
+ *  AsyncSinkPtr async = AsyncSink::instance(stderrSink);
+ *  mlog = Facility("tool", async);
+ *  ...
+ *  async->flush();
+ * @endcode
+ *
+ *  Thread safety: This class is thread-safe. */
+class SAWYER_EXPORT AsyncSink: public Destination {
+    struct Item {
+        Mesg mesg;
+        MesgProps props;
+        Item(const Mesg &mesg, const MesgProps &props): mesg(mesg), props(props) {}
+    };
+
+    DestinationPtr destination_;                        // wrapped final destination
+#include <Sawyer/WarningsOff.h>
+    std::vector<Item> queue_;                           // messages waiting for the background thread, protected by mutex_
+#include <Sawyer/WarningsRestore.h>
+    size_t nPending_;                                   // messages posted but not yet emitted, protected by mutex_
+    bool stopping_;                                     // set when the background thread should exit, protected by mutex_
+#if SAWYER_MULTI_THREADED
+    boost::condition_variable_any workAvailable_;       // signaled when queue_ becomes non-empty or stopping_ is set
+    boost::condition_variable_any workFinished_;        // signaled when nPending_ becomes zero
+    boost::thread *worker_;
+#endif
+
+protected:
+    /** Constructor for derived classes. Non-subclass users should use @ref instance instead. */
+    explicit AsyncSink(const DestinationPtr &destination);
+
+public:
+    /** Allocating constructor.
+     *
+     *  Constructs a sink that posts messages to @p destination from a background thread.  The @p destination must not be a
+     *  @ref Multiplexer; use one asynchronous sink per final destination instead. */
+    static AsyncSinkPtr instance(const DestinationPtr &destination) {
+        return AsyncSinkPtr(new AsyncSink(destination));
+    }
+
+    /** Destructor.
+     *
+     *  Emits all queued messages and waits for the background thread to exit. */
+    ~AsyncSink();
+
+    /** Wait for queued messages.
+     *
+     *  Blocks until every message posted before this call has been emitted by the wrapped destination. */
+    void flush();
+
+    virtual void bakeDestinations(const MesgProps&, BakedDestinations&) /*override*/;
+    virtual void post(const Mesg&, const MesgProps&) /*override*/;
+
+private:
+    void emitQueuedMessages();                          // runs in the background thread
+};
+
 #ifndef BOOST_WINDOWS
 /** Sends messages to the syslog daemon.
  *
@@ -1388,6 +1463,7 @@ class SAWYER_EXPORT Stream: public std::ostream {
     mutable SAWYER_THREAD_TRAITS::Mutex mutex_;
     size_t nrefs_;                                      // used when we don't have std::move semantics
     StreamBuf *streambuf_;                              // each stream has its own, protected by our mutex
+    AtomicBool isEnabled_;                              // copy of streambuf_->enabled_ readable without the mutex
 public:
 
     /** Construct a stream and initialize its name and importance properties. */
@@ -1456,9 +1532,13 @@ protected:
 
 public:
     /** Returns true if a stream is enabled.
+     *
+     *  This is cheap enough to call in inner loops: it reads a flag without acquiring any lock.
      *
      *  Thread safety: This method is thread-safe. */
-    bool enabled() const;
+    bool enabled() const {
+        return isEnabled_.load();
+    }
 
     // We'd like bool context to return a value that can't be used in arithmetic or comparison operators, but unfortunately
     // we need to also work with the super class (std::basic_ios) that has an implicit "void*" conversion which conflicts with
@@ -1499,6 +1579,21 @@ public:
     // See Stream::bool()
     #define SAWYER_MESG(message_stream) message_stream && message_stream
 
+    /** Emit a message only if the stream is enabled.
+     *
+     *  This is like @c SAWYER_MESG except the stream expression is evaluated only once, which matters when it's something like
+     *  <code>mlog[DEBUG]</code> that has to look up the stream, and the argument must be a @ref Stream rather than any
+     *  <code>std::ostream</code>.  None of the insertion operands are evaluated when the stream is disabled.  The macro expands
+     *  to a statement, not an expression.
+     *
+     * @code
+     *  SAWYER_LOG(mlog[DEBUG]) <<"the memory map is: " <<memoryMap <<"\n";
+     * @endcode */
+    #define SAWYER_LOG(message_stream) \
+        for (Sawyer::Message::Stream *sawyer_log_stream_ = &(message_stream); \
+             sawyer_log_stream_ && sawyer_log_stream_->enabled(); sawyer_log_stream_ = NULL) \
+            *sawyer_log_stream_
+
     /** Enable or disable a stream.
      *
      *  A disabled stream buffers the latest partial message and enabling the stream will cause the entire accumulated message
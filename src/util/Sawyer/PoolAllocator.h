@@ -10,8 +10,10 @@
 
 #include <boost/version.hpp>
 #include <boost/foreach.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/static_assert.hpp>
 #include <boost/cstdint.hpp>
+#include <boost/type_traits/is_same.hpp>
 #include <list>
 #include <Sawyer/Assert.h>
 #include <Sawyer/Interval.h>
@@ -48,6 +50,11 @@ namespace Sawyer {
  *
  *  The @ref SynchronizedPoolAllocator and @ref UnsynchronizedPoolAllocator typedefs provide reasonable template arguments.
  *
+ *  A multi-threaded allocator also has a thread-caching front end (see @ref threadCaching). Each thread that allocates from
+ *  the allocator gets a small private free list per pool, and cells move between those private lists and the shared pools
+ *  in batches of @c CACHE_BATCH cells. Most allocations and deallocations therefore acquire no locks at all. Cells held in a
+ *  thread's cache are returned to the shared pools when the thread exits.
+ *
  *  When a pool allocator is copied, only its settings are copied, not the pools.  Since containers typically copy their
  *  constructor-provided allocators, each container will have its own pools even if one provides the same pool to all the
  *  constructors.  See @ref ProxyAllocator for a way to avoid this, and to allow different containers to share the same
@@ -64,6 +71,21 @@ public:
     enum { N_POOLS = nPools };
     enum { CHUNK_SIZE = chunkSize };
     enum { N_FREE_LISTS = 32 };                          // number of free lists per pool
+    enum { CACHE_BATCH = 32 };                           // cells moved between a thread cache and a pool at once
+
+    /** Allocation statistics for one pool.
+     *
+     *  The counts are collected without walking the free lists and are therefore cheap enough to query often. */
+    struct PoolStatistics {
+        size_t cellSize;                                /**< Size of each cell in bytes. */
+        size_t nChunks;                                 /**< Number of chunks owned by the pool. */
+        size_t nLiveCells;                              /**< Cells currently allocated to callers. */
+        size_t nFreeCells;                              /**< Cells on the pool's shared free lists. */
+        size_t nCachedCells;                            /**< Free cells held in thread caches. */
+        size_t nCrossThreadFrees;                       /**< Cells freed by a thread other than the one that allocated them. */
+        PoolStatistics()
+            : cellSize(0), nChunks(0), nLiveCells(0), nFreeCells(0), nCachedCells(0), nCrossThreadFrees(0) {}
+    };
 
 private:
 
@@ -154,6 +176,11 @@ private:
         SAWYER_THREAD_TRAITS::Mutex freeListMutexes_[N_FREE_LISTS];
         FreeCell *freeLists_[N_FREE_LISTS];
 
+        // Statistics, each protected by the corresponding free-list mutex. Cells may be taken from one free list and returned
+        // to another, so only the sums across all free lists are meaningful.
+        boost::int64_t freeListSizes_[N_FREE_LISTS];    // number of cells on each free list
+        size_t nCrossThreadFrees_[N_FREE_LISTS];        // cross-thread frees reported by thread caches
+
         // The chunk-list stores the memory allocated for objects.  The chunk-list is protected by a mutex. When locking
         // free-list(s) and the chunk-list, the free-list locks should be aquired first.
         mutable SAWYER_THREAD_TRAITS::Mutex chunkMutex_;
@@ -163,7 +190,13 @@ private:
         Pool(const Pool&);                              // nonsense
 
     public:
-        Pool(): cellSize_(0) {}
+        Pool(): cellSize_(0) {
+            for (size_t i=0; i<N_FREE_LISTS; ++i) {
+                freeLists_[i] = NULL;
+                freeListSizes_[i] = 0;
+                nCrossThreadFrees_[i] = 0;
+            }
+        }
 
         void init(size_t cellSize) {
             assert(cellSize_ == 0);
@@ -182,23 +215,53 @@ private:
             return chunks_.empty();
         }
 
+        // Allocates a new chunk and makes its cells the content of the specified (empty) free list. The caller must hold the
+        // free-list lock.
+        void refillNS(size_t freeListIdx) {
+            ASSERT_require(freeLists_[freeListIdx] == NULL);
+            Chunk *chunk = new Chunk;
+            freeLists_[freeListIdx] = chunk->fill(cellSize_);
+            freeListSizes_[freeListIdx] += chunkSize / cellSize_;
+            SAWYER_THREAD_TRAITS::LockGuard lock(chunkMutex_);
+            chunks_.push_back(chunk);
+        }
+
         // Obtains the cell at the front of the free list, allocating more space if necessary.
         void* aquire() {                                // hot
             const size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
             SAWYER_THREAD_TRAITS::LockGuard lock(freeListMutexes_[freeListIdx]);
-            if (!freeLists_[freeListIdx]) {
-                Chunk *chunk = new Chunk;
-                freeLists_[freeListIdx] = chunk->fill(cellSize_);
-                SAWYER_THREAD_TRAITS::LockGuard lock(chunkMutex_);
-                chunks_.push_back(chunk);
-            }
+            if (!freeLists_[freeListIdx])
+                refillNS(freeListIdx);
             ASSERT_not_null(freeLists_[freeListIdx]);
             FreeCell *cell = freeLists_[freeListIdx];
             freeLists_[freeListIdx] = freeLists_[freeListIdx]->next;
+            --freeListSizes_[freeListIdx];
             cell->next = NULL;                          // optional
             return cell;
         }
 
+        // Moves up to nCells cells from a free list to the caller, allocating more space if necessary. Returns the number of
+        // cells moved, which is at least one.
+        size_t aquireBatch(size_t nCells, FreeCell *&list /*out*/) {
+            ASSERT_require(nCells > 0);
+            const size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
+            SAWYER_THREAD_TRAITS::LockGuard lock(freeListMutexes_[freeListIdx]);
+            if (!freeLists_[freeListIdx])
+                refillNS(freeListIdx);
+            FreeCell *head = freeLists_[freeListIdx], *tail = head;
+            ASSERT_not_null(head);
+            size_t n = 1;
+            while (n < nCells && tail->next) {
+                tail = tail->next;
+                ++n;
+            }
+            freeLists_[freeListIdx] = tail->next;
+            tail->next = NULL;
+            freeListSizes_[freeListIdx] -= n;
+            list = head;
+            return n;
+        }
+
         // Returns an cell to the front of the free list.
         void release(void *cell) {                      // hot
             const size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
@@ -207,6 +270,21 @@ private:
             FreeCell *freedCell = reinterpret_cast<FreeCell*>(cell);
             freedCell->next = freeLists_[freeListIdx];
             freeLists_[freeListIdx] = freedCell;
+            ++freeListSizes_[freeListIdx];
+        }
+
+        // Returns a list of cells from a thread cache to the front of a free list. The list runs from head to tail inclusive
+        // and contains nCells cells.
+        void releaseBatch(FreeCell *head, FreeCell *tail, size_t nCells, size_t nCrossThreadFrees) {
+            const size_t freeListIdx = fastRandomIndex(N_FREE_LISTS);
+            SAWYER_THREAD_TRAITS::LockGuard lock(freeListMutexes_[freeListIdx]);
+            if (head) {
+                ASSERT_not_null(tail);
+                tail->next = freeLists_[freeListIdx];
+                freeLists_[freeListIdx] = head;
+            }
+            freeListSizes_[freeListIdx] += nCells;
+            nCrossThreadFrees_[freeListIdx] += nCrossThreadFrees;
         }
 
         // Information about each chunk.
@@ -252,12 +330,14 @@ private:
                     newCells = cell->next;
                     cell->next = freeLists_[freeListIdx];
                     freeLists_[freeListIdx] = cell;
+                    ++freeListSizes_[freeListIdx];
                     if (++freeListIdx >= N_FREE_LISTS)
                         freeListIdx = 0;
                 }
 
-                if (nNeeded < cellsPerChunk)
+                if (nNeeded <= cellsPerChunk)
                     return;
+                nNeeded -= cellsPerChunk;
             }
         }
         
@@ -272,7 +352,9 @@ private:
             // belongs to a chunk that we're keeping, then copy the cell to a new free list.  The cells are copied round-robin
             // to the new free lists so that the lists stay balanced.
             FreeCell *newFreeLists[N_FREE_LISTS];
+            boost::int64_t newFreeListSizes[N_FREE_LISTS];
             memset(newFreeLists, 0, sizeof newFreeLists);
+            memset(newFreeListSizes, 0, sizeof newFreeListSizes);
             size_t newFreeListIdx = 0;
             for (size_t oldFreeListIdx=0; oldFreeListIdx<N_FREE_LISTS; ++oldFreeListIdx) {
                 FreeCell *next = NULL;
@@ -283,12 +365,14 @@ private:
                         // Keep this cell by round-robin inserting it into a new free list.
                         cell->next = newFreeLists[newFreeListIdx];
                         newFreeLists[newFreeListIdx] = cell;
+                        ++newFreeListSizes[newFreeListIdx];
                         if (++newFreeListIdx >= N_FREE_LISTS)
                             newFreeListIdx = 0;
                     }
                 }
             }
             memcpy(freeLists_, newFreeLists, sizeof newFreeLists);
+            memcpy(freeListSizes_, newFreeListSizes, sizeof newFreeListSizes);
 
             // Delete chunks that have no used cells.
             typename std::list<Chunk*>::iterator iter = chunks_.begin();
@@ -320,19 +404,23 @@ private:
             return totalUsed;
         }
 
-        std::pair<size_t, size_t> nAllocated() const {
-            ChunkInfoMap cim;
+        // Statistics for the shared part of the pool. The caller fills in the thread cache counts and the number of live
+        // cells.
+        PoolStatistics statistics() const {
+            PoolStatistics stats;
+            boost::int64_t nFree = 0;
             {
                 LockEverything guard(const_cast<SAWYER_THREAD_TRAITS::Mutex*>(freeListMutexes_), chunkMutex_);
-                cim = chunkInfoNS();
+                for (size_t i=0; i<N_FREE_LISTS; ++i) {
+                    nFree += freeListSizes_[i];
+                    stats.nCrossThreadFrees += nCrossThreadFrees_[i];
+                }
+                stats.nChunks = chunks_.size();
             }
-
-            const size_t nCells = chunkSize / cellSize_;
-            size_t nReserved = nCells * cim.nIntervals();
-            size_t nAllocated = 0;
-            BOOST_FOREACH (const ChunkInfo &info, cim.values())
-                nAllocated += info.nUsed;
-            return std::make_pair(nAllocated, nReserved);
+            ASSERT_require(nFree >= 0);
+            stats.cellSize = cellSize_;
+            stats.nFreeCells = nFree;
+            return stats;
         }
     };
 
@@ -340,13 +428,133 @@ private:
     //                                  Private data members and methods
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 private:
+    class ThreadCache;
+
+    // Shared between an allocator and its thread caches so that a cache which outlives its allocator (e.g., a thread that
+    // exits after the allocator is destroyed) knows not to return its cells.
+    struct CacheRegistry {
+        SAWYER_THREAD_TRAITS::Mutex mutex;
+        PoolAllocatorBase *allocator;                   // null after the allocator is destroyed
+        std::list<ThreadCache*> caches;                 // caches of all threads that have used the allocator
+        explicit CacheRegistry(PoolAllocatorBase *allocator): allocator(allocator) {}
+    };
+
+    // Per-thread free lists, one per pool. Only the owning thread touches a cache, except that its destructor runs when the
+    // thread exits.
+    class ThreadCache {
+        boost::shared_ptr<CacheRegistry> registry_;
+        FreeCell *cells_[nPools];                       // free cells private to this thread
+        size_t nCells_[nPools];                         // length of each cells_ list
+        size_t nHeld_[nPools];                          // cells allocated by this thread and not yet freed by it
+        size_t nCrossThreadFrees_[nPools];              // not yet reported to the pool
+
+    public:
+        explicit ThreadCache(const boost::shared_ptr<CacheRegistry> &registry)
+            : registry_(registry) {
+            for (size_t pn=0; pn<nPools; ++pn) {
+                cells_[pn] = NULL;
+                nCells_[pn] = nHeld_[pn] = nCrossThreadFrees_[pn] = 0;
+            }
+            SAWYER_THREAD_TRAITS::LockGuard lock(registry_->mutex);
+            registry_->caches.push_back(this);
+        }
+
+        ~ThreadCache() {
+            SAWYER_THREAD_TRAITS::LockGuard lock(registry_->mutex);
+            registry_->caches.remove(this);
+            if (PoolAllocatorBase *allocator = registry_->allocator) {
+                for (size_t pn=0; pn<nPools; ++pn) {
+                    FreeCell *tail = cells_[pn];
+                    while (tail && tail->next)
+                        tail = tail->next;
+                    allocator->pools_[pn].releaseBatch(cells_[pn], tail, nCells_[pn], nCrossThreadFrees_[pn]);
+                }
+            }
+        }
+
+        const CacheRegistry* registry() const {
+            return registry_.get();
+        }
+
+        // Counters read by other threads for statistics. These are read without synchronization and are therefore only
+        // approximate while the owning thread is running.
+        size_t nCells(size_t pn) const { return nCells_[pn]; }
+        size_t nCrossThreadFrees(size_t pn) const { return nCrossThreadFrees_[pn]; }
+
+        void* aquire(Pool &pool, size_t pn) {           // hot
+            if (!cells_[pn])
+                nCells_[pn] = pool.aquireBatch(CACHE_BATCH, cells_[pn] /*out*/);
+            FreeCell *cell = cells_[pn];
+            cells_[pn] = cell->next;
+            --nCells_[pn];
+            ++nHeld_[pn];
+            cell->next = NULL;                          // optional
+            return cell;
+        }
+
+        void release(Pool &pool, size_t pn, void *addr) { // hot
+            FreeCell *cell = reinterpret_cast<FreeCell*>(addr);
+            cell->next = cells_[pn];
+            cells_[pn] = cell;
+            ++nCells_[pn];
+
+            // A thread that frees more cells than it allocated must be freeing cells that some other thread allocated. This
+            // undercounts when a thread frees a foreign cell while still holding its own, but costs nothing per cell.
+            if (nHeld_[pn] > 0) {
+                --nHeld_[pn];
+            } else {
+                ++nCrossThreadFrees_[pn];
+            }
+
+            if (nCells_[pn] >= 2 * CACHE_BATCH) {
+                // Keep the most recently freed cells (they're likely still in this CPU's cache) and return the rest.
+                FreeCell *last = cells_[pn];
+                for (size_t i=1; i<CACHE_BATCH; ++i)
+                    last = last->next;
+                FreeCell *head = last->next, *tail = head;
+                last->next = NULL;
+                size_t n = 1;
+                while (tail->next) {
+                    tail = tail->next;
+                    ++n;
+                }
+                nCells_[pn] -= n;
+                pool.releaseBatch(head, tail, n, nCrossThreadFrees_[pn]);
+                nCrossThreadFrees_[pn] = 0;
+            }
+        }
+    };
+
     Pool *pools_;                                       // modified only in constructors and destructor
+    bool threadCaching_;
+    boost::shared_ptr<CacheRegistry> registry_;
+#if SAWYER_MULTI_THREADED
+    boost::thread_specific_ptr<ThreadCache> threadCaches_;
+#endif
 
     // Called only by constructors
     void init() {
         pools_ = new Pool[nPools];
         for (size_t i=0; i<nPools; ++i)
             pools_[i].init(cellSize(i));
+        threadCaching_ = isThreadCachingSupported();
+        registry_ = boost::shared_ptr<CacheRegistry>(new CacheRegistry(this));
+    }
+
+    // The calling thread's cache, created if necessary. Returns null if thread caching is not supported.
+    ThreadCache* threadCache() {                        // hot
+#if SAWYER_MULTI_THREADED
+        ThreadCache *cache = threadCaches_.get();
+        if (!cache || cache->registry() != registry_.get()) {
+            // A cache whose registry differs belongs to a destroyed allocator that used to live at this same address. Resetting
+            // deletes it, and its destructor knows not to touch the old pools.
+            cache = new ThreadCache(registry_);
+            threadCaches_.reset(cache);
+        }
+        return cache;
+#else
+        return NULL;
+#endif
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -362,8 +570,9 @@ public:
      *
      *  Copying an allocator does not copy its pools, but rather creates a new allocator that is empty but has the same
      *  settings as the source allocator. */
-    PoolAllocatorBase(const PoolAllocatorBase&) {
+    PoolAllocatorBase(const PoolAllocatorBase &other) {
         init();
+        threadCaching_ = other.threadCaching_;
     }
 
 private:
@@ -376,6 +585,10 @@ public:
      *  Destroying a pool allocator destroys all its pools, which means that any objects that use storage managed by this pool
      *  will have their storage deleted. */
     virtual ~PoolAllocatorBase() {
+        {
+            SAWYER_THREAD_TRAITS::LockGuard lock(registry_->mutex);
+            registry_->allocator = NULL;
+        }
         delete[] pools_;
     }
 
@@ -406,6 +619,38 @@ public:
         return chunkSize / cellSize(poolNumber);
     }
 
+    /** Whether thread caching is possible.
+     *
+     *  Thread caching requires a multi-threaded allocator (the @p Sync template argument is @ref MultiThreadedTag) in a
+     *  library configured with multi-threading support. */
+    static bool isThreadCachingSupported() {
+#if SAWYER_MULTI_THREADED
+        return boost::is_same<Sync, MultiThreadedTag>::value;
+#else
+        return false;
+#endif
+    }
+
+    /** Property: Whether to use per-thread caches.
+     *
+     *  When enabled, each thread allocates from and deallocates to a small private free list per pool, and cells are moved
+     *  between the private lists and the shared pools @c CACHE_BATCH at a time. This avoids nearly all locking, at the cost
+     *  of up to <code>2*CACHE_BATCH</code> idle cells per pool per thread. Cells held in thread caches keep their chunks from
+     *  being reclaimed by @ref vacuum until the thread exits. Thread caching is enabled by default when it is supported, and
+     *  enabling it has no effect when it is not supported.
+     *
+     *  Thread safety: This property should only be changed before the allocator is shared by multiple threads. Disabling it
+     *  later is safe, but cells already in thread caches stay there until their threads exit.
+     *
+     * @{ */
+    bool threadCaching() const {
+        return threadCaching_;
+    }
+    void threadCaching(bool b) {
+        threadCaching_ = b && isThreadCachingSupported();
+    }
+    /** @} */
+
     /** Allocate one object of specified size.
      *
      *  Allocates one cell from an allocation pool, using the pool with the smallest-sized cells that are large enough to
@@ -420,7 +665,13 @@ public:
     void *allocate(size_t size) {                       // hot
         ASSERT_require(size>0);
         size_t pn = poolNumber(size);
-        return pn < nPools ? pools_[pn].aquire() : ::operator new(size);
+        if (pn >= nPools)
+            return ::operator new(size);
+        if (threadCaching_) {
+            if (ThreadCache *cache = threadCache())
+                return cache->aquire(pools_[pn], pn);
+        }
+        return pools_[pn].aquire();
     }
 
     /** Reserve a certain number of objects in the pool.
@@ -432,7 +683,7 @@ public:
      *  should reserve slightly more than what will be needed. Reserving storage is entirely optional. */
     void reserve(size_t objectSize, size_t nObjects) {
         ASSERT_require(objectSize > 0);
-        size_t pn = poolNumber(nObjects);
+        size_t pn = poolNumber(objectSize);
         if (pn >= nPools)
             return;
         pools_[pn].reserve(nObjects);
@@ -447,14 +698,41 @@ public:
      *  time they're returned to the caller */
     std::pair<size_t, size_t> nAllocated() const {
         size_t nAllocated = 0, nReserved = 0;
+        std::vector<PoolStatistics> stats = statistics();
         for (size_t pn=0; pn<nPools; ++pn) {
-            std::pair<size_t, size_t> pp = pools_[pn].nAllocated();
-            nAllocated += pp.first;
-            nReserved += pp.second;
+            nAllocated += stats[pn].nLiveCells;
+            nReserved += stats[pn].nChunks * nCells(pn);
         }
         return std::make_pair(nAllocated, nReserved);
     }
     
+    /** Allocation statistics.
+     *
+     *  Returns statistics for each pool, indexed by pool number. Cross-thread frees are counted only when thread caching is
+     *  enabled. A thread that frees a cell allocated by another thread is only detected when it has freed more cells than it
+     *  allocated, therefore the count is a lower bound.
+     *
+     *  Thread safety: This method is thread-safe, but it reads the thread cache counters of other threads without
+     *  synchronizing with those threads, so the counts for threads that are concurrently allocating or freeing are
+     *  approximate. */
+    std::vector<PoolStatistics> statistics() const {
+        SAWYER_THREAD_TRAITS::LockGuard lock(registry_->mutex);
+        std::vector<PoolStatistics> retval;
+        retval.reserve(nPools);
+        for (size_t pn=0; pn<nPools; ++pn) {
+            PoolStatistics stats = pools_[pn].statistics();
+            BOOST_FOREACH (const ThreadCache *cache, registry_->caches) {
+                stats.nCachedCells += cache->nCells(pn);
+                stats.nCrossThreadFrees += cache->nCrossThreadFrees(pn);
+            }
+            const size_t capacity = stats.nChunks * nCells(pn);
+            const size_t nIdle = stats.nFreeCells + stats.nCachedCells;
+            stats.nLiveCells = capacity > nIdle ? capacity - nIdle : 0; // cache counts may be stale
+            retval.push_back(stats);
+        }
+        return retval;
+    }
+
     /** Deallocate an object of specified size.
      *
      *  The @p addr must be an object address that was previously returned by the @ref allocate method and which hasn't been
@@ -468,10 +746,12 @@ public:
         if (addr) {
             ASSERT_require(size>0);
             size_t pn = poolNumber(size);
-            if (pn < nPools) {
-                pools_[pn].release(addr);
-            } else {
+            if (pn >= nPools) {
                 ::operator delete(addr);
+            } else if (ThreadCache *cache = threadCaching_ ? threadCache() : NULL) {
+                cache->release(pools_[pn], pn, addr);
+            } else {
+                pools_[pn].release(addr);
             }
         }
     }
@@ -10,6 +10,10 @@
 
 #include <Sawyer/Sawyer.h>
 
+#if __cplusplus >= 201103L
+    #include <atomic>
+#endif
+
 #if SAWYER_MULTI_THREADED
     // It appears as though a certain version of GNU libc interacts badly with C++03 GCC and LLVM compilers. Some system header
     // file defines _XOPEN_UNIX as "1" and __UINTPTR_TYPE__ as "unsigned long int" but doesn't provide a definition for
@@ -94,6 +98,49 @@ public:
     LockGuard2(NullMutex&, NullMutex&) {}
 };
 
+/** Boolean that can be read without locking.
+ *
+ *  This is intended for fast-path checks of state that is otherwise protected by a mutex, such as whether a message stream is
+ *  enabled.  A store by one thread is eventually seen by loads in other threads, and a load that sees a stored value also sees
+ *  everything the storing thread wrote before the store.  This uses C++11 atomics when available, compiler intrinsics for GCC
+ *  and LLVM, and a volatile variable otherwise. */
+class AtomicBool {
+#if __cplusplus >= 201103L
+    std::atomic<bool> value_;
+#else
+    volatile bool value_;
+#endif
+
+public:
+    explicit AtomicBool(bool b = false): value_(b) {}
+
+    /** Read the value. */
+    bool load() const {
+#if __cplusplus >= 201103L
+        return value_.load(std::memory_order_acquire);
+#elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+        return __atomic_load_n(&value_, __ATOMIC_ACQUIRE);
+#else
+        return value_;
+#endif
+    }
+
+    /** Write the value. */
+    void store(bool b) {
+#if __cplusplus >= 201103L
+        value_.store(b, std::memory_order_release);
+#elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+        __atomic_store_n(&value_, b, __ATOMIC_RELEASE);
+#else
+        value_ = b;
+#endif
+    }
+
+private:
+    AtomicBool(const AtomicBool&);                      // not copyable
+    AtomicBool& operator=(const AtomicBool&);
+};
+
 /** Traits for thread synchronization. */
 template<typename SyncTag>
 struct SynchronizationTraits {};
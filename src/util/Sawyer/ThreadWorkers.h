@@ -4,6 +4,8 @@
 
 
 
+#ifndef Sawyer_ThreadWorkers_H
+#define Sawyer_ThreadWorkers_H
 
 #include <Sawyer/Exception.h>
 #include <Sawyer/Graph.h>
@@ -269,3 +271,5 @@ workInParallel(const DependencyGraph &dependencies, size_t nWorkers, Functor fun
 
 
 } // namespace
+
+#endif
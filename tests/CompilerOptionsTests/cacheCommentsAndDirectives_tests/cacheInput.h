@@ -0,0 +1,18 @@
+// Header included by both test codes; its comments and directives are lexed once when they are cached.
+#ifndef CACHE_INPUT_H
+#define CACHE_INPUT_H
+
+/* Declaration with a C-style comment */
+int sharedFunction(int x);
+
+#define SHARED_VALUE 42
+
+// Class with comments before and inside it
+class SharedClass
+   {
+     public:
+       // Member comment
+          int value;
+   };
+
+#endif